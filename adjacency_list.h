@@ -14,11 +14,17 @@
 #include <iostream>
 #include <vector>
 #include <queue>
+#include "graph_instrumentation.h"
+#include "path_search.h"
 
 template<class T, bool Direction=false, class W=int>
 class AdjacencyList
 {
 public:
+	typedef T VertexType;
+	typedef W WeightType;
+	template<class, bool, class> friend class Graph;
+	
 	class EdgeNode
 	{
 	public:
@@ -66,6 +72,10 @@ public:
 	int getEdgeCount() const;
 	bool isDirected() const;
 	bool isEdge(const T& srcVertex, const T& dstVertex) const;
+	const T& getVertex(const int& index) const;
+	int getVertexIndex(const T& vertex) const;
+	template<class Visitor>
+	void forEachAdjacent(const int& srcIndex, Visitor visit) const;
 	void addVertex(const T& vertex);
 	void eraseVertex(const T& vertexToDelete);
 	void addEdge(const T& srcVertex, const T& dstVertex, const W& weight = true);
@@ -78,18 +88,22 @@ public:
 	void BFS() const;
 	void BFSInConnectedComponents() const;
 	AdjacencyList* inverseAdjacencyList();
+	std::vector<T> shortestPath(const T& srcVertex, const T& dstVertex);
+	template<class Heuristic>
+	std::vector<T> aStarPath(const T& srcVertex, const T& dstVertex, Heuristic heuristic);
 	
 private:
 	int LocateVertexIndex(const T& vertex) const;
 	EdgeNode* findEdgeNode(const int& srcIndex, const T& targetVertex) const;
-	void addEdge(const int& srcIndex, const int& dstIndex, const W& weight, const bool& = true);
-	void eraseEdge(const int& srcIndex, const int& dstIndex, const T& srcVertex, const T& dstVertex);
+	void addEdgeNode(const int& srcIndex, const int& dstIndex, const W& weight);
+	bool eraseEdgeNode(const int& srcIndex, const int& dstIndex);
 	void DFS(std::vector<int>& visited, size_t srcIndex) const;
 	void BFS(std::vector<int>& visited, size_t srcIndex) const;
 	
 private:
 	std::vector<VertexNode*>* vertexList;
 	int edgeCount;
+	PathSearchScratch<W> pathScratch; // reused by every shortestPath/aStarPath call
 };
 
 template<class T, bool Direction, class W>
@@ -135,9 +149,11 @@ template<class T, bool Direction, class W>
 typename AdjacencyList<T, Direction, W>::EdgeNode*
 AdjacencyList<T, Direction, W>::findEdgeNode(const int& srcIndex, const T& targetVertex) const
 {
+	GRAPH_COUNT(findEdgeCalls, 1);
 	EdgeNode* current = vertexList->at(srcIndex)->head;
 	while(current != nullptr)
 	{
+		GRAPH_COUNT(findEdgeChain, 1);
 		if(vertexList->at(current->index)->vertex == targetVertex)
 			return current;
 		current = current->nextNode;
@@ -170,6 +186,7 @@ template<class T, bool Direction, class W>
 bool
 AdjacencyList<T, Direction, W>::isEdge(const T& srcVertex, const T& dstVertex) const
 {
+	GRAPH_TIME_SCOPE(isEdge);
 	int srcIndex = LocateVertexIndex(srcVertex);
 	if(srcIndex == -1) return false;
 	EdgeNode* current = findEdgeNode(srcIndex, dstVertex);
@@ -178,11 +195,41 @@ AdjacencyList<T, Direction, W>::isEdge(const T& srcVertex, const T& dstVertex) c
 	return false;
 }
 
+template<class T, bool Direction, class W>
+const T&
+AdjacencyList<T, Direction, W>::getVertex(const int& index) const
+{
+	return vertexList->at(index)->vertex;
+}
+
+template<class T, bool Direction, class W>
+int
+AdjacencyList<T, Direction, W>::getVertexIndex(const T& vertex) const
+{
+	return LocateVertexIndex(vertex);
+}
+
+/*
+**	Calls visit(dstIndex, weight) for every edge leaving srcIndex;
+**	the index-level hook the algorithms outside this class traverse through;
+*/
+template<class T, bool Direction, class W>
+template<class Visitor>
+void
+AdjacencyList<T, Direction, W>::forEachAdjacent(const int& srcIndex, Visitor visit) const
+{
+	for(EdgeNode* current = vertexList->at(srcIndex)->head; current != nullptr; current = current->nextNode)
+	{
+		visit(current->index, current->weight);
+	}
+}
+
 template<class T, bool Direction, class W>
 void
 AdjacencyList<T, Direction, W>::addVertex(const T& vertex)
 {
-	VertexNode* newVertexNode = new VertexNode(vertex);
+	GRAPH_TIME_SCOPE(addVertex);
+	pathScratch.invalidate();
 	vertexList->push_back(new VertexNode(vertex));
 }
 
@@ -190,19 +237,44 @@ template<class T, bool Direction, class W>
 void
 AdjacencyList<T, Direction, W>::eraseVertex(const T& vertexToDelete)
 {
+	GRAPH_TIME_SCOPE(eraseVertex);
+	pathScratch.invalidate();
 	int toDeleteIndex = LocateVertexIndex(vertexToDelete);
-	EdgeNode* edgeToDelete = vertexList->at(toDeleteIndex)->head->nextNode;
+	if(toDeleteIndex == -1) return;
+	for(size_t i = 0; i < vertexList->size(); ++i)
+	{
+		if(static_cast<int>(i) == toDeleteIndex) continue;
+		while(eraseEdgeNode(i, toDeleteIndex))
+		{
+			if(Direction)
+				--edgeCount;
+		}
+	}
+	int outEdges = 0, selfLoops = 0;
+	EdgeNode* edgeToDelete = vertexList->at(toDeleteIndex)->head;
 	while(edgeToDelete != nullptr)
 	{
-		edgeToDelete = vertexList->at(toDeleteIndex)->head->nextNode;
-		delete vertexList->at(toDeleteIndex)->head;
-		vertexList->at(toDeleteIndex)->head = edgeToDelete;
+		EdgeNode* nextNode = edgeToDelete->nextNode;
+		if(edgeToDelete->index == toDeleteIndex)
+			++selfLoops;
+		++outEdges;
+		delete edgeToDelete;
+		edgeToDelete = nextNode;
 	}
-	std::swap(vertexList->at(toDeleteIndex), vertexList->at(vertexList->size()-1));
+	edgeCount -= Direction ? outEdges : outEdges - selfLoops + selfLoops / 2;
+	delete vertexList->at(toDeleteIndex);
+	
+	// the last vertex takes over the freed slot, so edges into it are renumbered
+	int lastIndex = vertexList->size() - 1;
+	vertexList->at(toDeleteIndex) = vertexList->at(lastIndex);
 	vertexList->pop_back();
-	for(size_t i = 0; i < vertexList->size(); ++i)
+	for(auto &i : *vertexList)
 	{
-		eraseEdge(vertexList->at(i)->vertex, vertexToDelete);
+		for(EdgeNode* current = i->head; current != nullptr; current = current->nextNode)
+		{
+			if(current->index == lastIndex)
+				current->index = toDeleteIndex;
+		}
 	}
 }
 
@@ -210,19 +282,22 @@ template<class T, bool Direction, class W>
 void
 AdjacencyList<T, Direction, W>::addEdge(const T& srcVertex, const T& dstVertex, const W& weight)
 {
+	GRAPH_TIME_SCOPE(addEdge);
+	pathScratch.invalidate();
 	int srcIndex = LocateVertexIndex(srcVertex);
 	int dstIndex = LocateVertexIndex(dstVertex);
 	if(srcIndex == -1 || dstIndex == -1) return;
-	addEdge(srcIndex, dstIndex, weight, true);
+	addEdgeNode(srcIndex, dstIndex, weight);
 	++edgeCount;
 	if(!Direction)
-		addEdge(dstIndex, srcIndex, weight, true);
+		addEdgeNode(dstIndex, srcIndex, weight);
 }
 
 template<class T, bool Direction, class W>
 void
-AdjacencyList<T, Direction, W>::addEdge(const int& srcIndex, const int& dstIndex, const W& weight, const bool&)
+AdjacencyList<T, Direction, W>::addEdgeNode(const int& srcIndex, const int& dstIndex, const W& weight)
 {
+	GRAPH_COUNT(edgeAllocations, 1);
 	EdgeNode* newEdge = new EdgeNode(dstIndex, weight);
 	newEdge->nextNode = vertexList->at(srcIndex)->head;
 	vertexList->at(srcIndex)->head = newEdge;
@@ -232,58 +307,37 @@ template<class T, bool Direction, class W>
 void
 AdjacencyList<T, Direction, W>::eraseEdge(const T& srcVertex, const T& dstVertex)
 {
+	GRAPH_TIME_SCOPE(eraseEdge);
+	pathScratch.invalidate();
 	int srcIndex = LocateVertexIndex(srcVertex);
 	int dstIndex = LocateVertexIndex(dstVertex);
 	if(srcIndex == -1 || dstIndex == -1) return;
-	eraseEdge(srcIndex, dstIndex, srcVertex, dstVertex);
+	if(!eraseEdgeNode(srcIndex, dstIndex)) return;
 	--edgeCount;
 	if(!Direction)
-		eraseEdge(dstIndex, srcIndex, dstVertex, srcVertex);
+		eraseEdgeNode(dstIndex, srcIndex);
 }
 
 template<class T, bool Direction, class W>
-void
-AdjacencyList<T, Direction, W>::eraseEdge(const int& srcIndex, const int& dstIndex, const T& srcVertex, const T& dstVertex)
+bool
+AdjacencyList<T, Direction, W>::eraseEdgeNode(const int& srcIndex, const int& dstIndex)
 {
-	EdgeNode*& current = vertexList->at(srcIndex)->head;
-	if(vertexList->at(current->index)->vertex == dstVertex)
-	{
-		if(current->nextNode != nullptr)
-		{
-			EdgeNode*& toDelete = current;
-			vertexList->at(srcIndex)->head = current->nextNode;
-			delete toDelete;
-			toDelete = nullptr;
-			return;
-		}
-		else if(current->nextNode == nullptr)
-		{
-			delete vertexList->at(srcIndex)->head;
-			vertexList->at(srcIndex)->head = nullptr;
-			return;
-		}
-	}
-	while(vertexList->at(current->nextNode->index)->vertex != dstVertex)
-		current = current->nextNode;
-	EdgeNode*& toDelete = current->nextNode;
-	if(toDelete->nextNode != nullptr)
-	{
-		current->nextNode = toDelete->nextNode;
-		delete toDelete;
-		toDelete = nullptr;
-	}
-	else if(toDelete->nextNode == nullptr)
-	{
-		current->nextNode = nullptr;
-		delete toDelete;
-		toDelete = nullptr;
-	}
+	EdgeNode** link = &vertexList->at(srcIndex)->head;
+	while(*link != nullptr && (*link)->index != dstIndex)
+		link = &(*link)->nextNode;
+	if(*link == nullptr)
+		return false;
+	EdgeNode* toDelete = *link;
+	*link = toDelete->nextNode;
+	delete toDelete;
+	return true;
 }
 
 template<class T, bool Direction, class W>
 void
 AdjacencyList<T, Direction, W>::DFS(const T& srcVertex) const
 {
+	GRAPH_TIME_SCOPE(DFS);
 	std::vector<int> visited(vertexList->size(), false);
 	std::cout << "DFS: ";
 	DFS(visited, LocateVertexIndex(srcVertex));
@@ -294,6 +348,7 @@ template<class T, bool Direction, class W>
 void
 AdjacencyList<T, Direction, W>::DFS() const
 {
+	GRAPH_TIME_SCOPE(DFS);
 	std::vector<int> visited(vertexList->size(), false);
 	std::cout << "DFS: ";
 	DFS(visited, 0);
@@ -304,6 +359,7 @@ template<class T, bool Direction, class W>
 void
 AdjacencyList<T, Direction, W>::DFSInConnectedComponents() const
 {
+	GRAPH_TIME_SCOPE(DFSInConnectedComponents);
 	std::vector<int> visited(vertexList->size(), false);
 	std::cout << "DFS in Connected Components: ";
 	for(size_t i = 0; i < vertexList->size(); ++i)
@@ -318,11 +374,13 @@ template<class T, bool Direction, class W>
 void
 AdjacencyList<T, Direction, W>::DFS(std::vector<int>& visited, size_t srcIndex) const
 {
+	GRAPH_COUNT(dfsVertices, 1);
 	std::cout << vertexList->at(srcIndex)->vertex << " ";
 	visited.at(srcIndex) = true;
 	EdgeNode* current = vertexList->at(srcIndex)->head;
 	while(current != nullptr)
 	{
+		GRAPH_COUNT(dfsEdges, 1);
 		if(visited.at(current->index) == false)
 		{
 			DFS(visited, current->index);
@@ -335,6 +393,7 @@ template<class T, bool Direction, class W>
 void
 AdjacencyList<T, Direction, W>::BFS(const T& srcVertex) const
 {
+	GRAPH_TIME_SCOPE(BFS);
 	std::vector<int> visited(vertexList->size(), false);
 	std::cout << "BFS: ";
 	BFS(visited, LocateVertexIndex(srcVertex));
@@ -345,6 +404,7 @@ template<class T, bool Direction, class W>
 void
 AdjacencyList<T, Direction, W>::BFS() const
 {
+	GRAPH_TIME_SCOPE(BFS);
 	std::vector<int> visited(vertexList->size(), false);
 	std::cout << "BFS: ";
 	BFS(visited, 0);
@@ -355,6 +415,7 @@ template<class T, bool Direction, class W>
 void
 AdjacencyList<T, Direction, W>::BFSInConnectedComponents() const
 {
+	GRAPH_TIME_SCOPE(BFSInConnectedComponents);
 	std::vector<int> visited(vertexList->size(), false);
 	std::cout << "BFS in Connected Components: ";
 	for(size_t i = 0; i < vertexList->size(); ++i)
@@ -378,10 +439,12 @@ AdjacencyList<T, Direction, W>::BFS(std::vector<int>& visited, size_t srcIndex)
 	{
 		int front = q.front();
 		q.pop();
+		GRAPH_COUNT(bfsVertices, 1);
 		std::cout << vertexList->at(front)->vertex << " ";
 		EdgeNode* current = vertexList->at(front)->head;
 		while(current != nullptr)
 		{
+			GRAPH_COUNT(bfsEdges, 1);
 			if(visited.at(current->index) == false)
 			{
 				q.push(current->index);
@@ -396,35 +459,58 @@ template<class T, bool Direction, class W>
 AdjacencyList<T, Direction, W>*
 AdjacencyList<T, Direction, W>::inverseAdjacencyList()
 {
+	GRAPH_TIME_SCOPE(inverseAdjacencyList);
 	if(Direction == false)
 		return nullptr;
 	std::vector<T> vertexs(vertexList->size());
 	for(size_t i = 0; i < vertexList->size(); ++i)
 		vertexs.at(i) = vertexList->at(i)->vertex;
 	AdjacencyList* InAL = new AdjacencyList(vertexs);
+	// indices match, so link the nodes directly instead of through the timed addEdge
 	for(size_t i = 0; i < vertexList->size(); ++i)
 	{
-		EdgeNode* current = vertexList->at(i)->head;
-		if(current != nullptr)
-			InAL->addEdge(InAL->vertexList->at(current->index)->vertex, InAL->vertexList->at(i)->vertex);
-		while(current != nullptr)
-		{
-			InAL->addEdge(InAL->vertexList->at(current->index)->vertex, InAL->vertexList->at(i)->vertex);
-			current = current->nextNode;
-		}
+		for(EdgeNode* current = vertexList->at(i)->head; current != nullptr; current = current->nextNode)
+			InAL->addEdgeNode(current->index, i, current->weight);
 	}
+	InAL->edgeCount = edgeCount;
 	return InAL;
 }
 
+template<class T, bool Direction, class W>
+std::vector<T>
+AdjacencyList<T, Direction, W>::shortestPath(const T& srcVertex, const T& dstVertex)
+{
+	GRAPH_TIME_SCOPE(shortestPath);
+	return ::bidirectionalDijkstraPath(*this, pathScratch, srcVertex, dstVertex);
+}
+
+/*
+**	heuristic(vertex, dstVertex) estimates the remaining distance and must
+**	not overestimate it;
+*/
+template<class T, bool Direction, class W>
+template<class Heuristic>
+std::vector<T>
+AdjacencyList<T, Direction, W>::aStarPath(const T& srcVertex, const T& dstVertex, Heuristic heuristic)
+{
+	GRAPH_TIME_SCOPE(aStarPath);
+	return ::aStarPath(*this, pathScratch, srcVertex, dstVertex, heuristic);
+}
+
 template<class T, bool Direction, class W>
 int
 AdjacencyList<T, Direction, W>::LocateVertexIndex(const T& vertex) const
 {
+	GRAPH_COUNT(locateVertexCalls, 1);
 	for(size_t i = 0; i < vertexList->size(); ++i)
 	{
 		if(vertexList->at(i)->vertex == vertex)
+		{
+			GRAPH_COUNT(locateVertexScan, i + 1);
 			return i;
+		}
 	}
+	GRAPH_COUNT(locateVertexScan, vertexList->size());
 	return -1;
 }
 
@@ -432,6 +518,7 @@ template<class T, bool Direction, class W>
 void
 AdjacencyList<T, Direction, W>::clear()
 {
+	GRAPH_TIME_SCOPE(clear);
 	if(vertexList == nullptr)
 		return;
 	for(auto &i : *vertexList)
@@ -443,6 +530,7 @@ AdjacencyList<T, Direction, W>::clear()
 			delete i->head;
 			i->head = current;
 		}
+		delete i;
 	}
 	delete vertexList;
 	vertexList = nullptr;
@@ -15,8 +15,10 @@
 #include <vector>
 #include <queue>
 #include <utility>
-#include <queue>
+#include <limits>
 #include <unordered_map>
+#include "graph_instrumentation.h"
+#include "path_search.h"
 
 template<class T, class W>
 struct DijkstraNode
@@ -48,6 +50,11 @@ public:
 template<class T, bool Direction=false, class W=int>
 class AdjacencyMatrix
 {
+public:
+	typedef T VertexType;
+	typedef W WeightType;
+	template<class, bool, class> friend class Graph;
+	
 public:
 	AdjacencyMatrix(const int& capacity, const T* vertexs);
 	AdjacencyMatrix(const std::vector<T>& vertexs);
@@ -58,6 +65,12 @@ public:
 	int getEdgeCount() const;
 	bool isDirected() const;
 	bool isEdge(const T& srcVertex, const T& dstVertex) const;
+	const T& getVertex(const int& index) const;
+	int getVertexIndex(const T& vertex) const;
+	template<class Visitor>
+	void forEachAdjacent(const int& srcIndex, Visitor visit) const;
+	void addVertex(const T& vertex);
+	void eraseVertex(const T& vertexToDelete);
 	void addEdge(const T& srcVertex, const T& dstVertex, const W& weight = 1);
 	void eraseEdge(const T& srcVertex, const T& dstVertex);
 	void DFS(const T& srcVertex) const;
@@ -67,6 +80,9 @@ public:
 	void BFS() const;
 	void BFSInConnectedComponents() const;
 	void dijkstraPath(T secVertex);
+	std::vector<T> shortestPath(const T& srcVertex, const T& dstVertex);
+	template<class Heuristic>
+	std::vector<T> aStarPath(const T& srcVertex, const T& dstVertex, Heuristic heuristic);
 	void printMatrix() const;
 	void clear();
 	
@@ -79,6 +95,7 @@ private:
 	std::vector<T>* vertexArray;
 	std::vector<std::vector<W>>* edgeMatrix;
 	int edgeCount;
+	PathSearchScratch<W> pathScratch; // reused by every shortestPath/aStarPath call
 };
 
 template<class T, bool Direction, class W>
@@ -149,6 +166,7 @@ template<class T, bool Direction, class W>
 bool
 AdjacencyMatrix<T, Direction, W>::isEdge(const T& srcVertex, const T& dstVertex) const
 {
+	GRAPH_TIME_SCOPE(isEdge);
 	int srcIndex = LocateVertexIndex(srcVertex);
 	int dstIndex = LocateVertexIndex(dstVertex);
 	if(srcIndex == -1 || dstIndex == -1) return false;
@@ -157,15 +175,90 @@ AdjacencyMatrix<T, Direction, W>::isEdge(const T& srcVertex, const T& dstVertex)
 	return edgeMatrix->at(srcIndex).at(dstIndex) != W() || edgeMatrix->at(dstIndex).at(srcIndex) != W();
 }
 
+template<class T, bool Direction, class W>
+const T&
+AdjacencyMatrix<T, Direction, W>::getVertex(const int& index) const
+{
+	return vertexArray->at(index);
+}
+
+template<class T, bool Direction, class W>
+int
+AdjacencyMatrix<T, Direction, W>::getVertexIndex(const T& vertex) const
+{
+	return LocateVertexIndex(vertex);
+}
+
+/*
+**	Calls visit(dstIndex, weight) for every edge leaving srcIndex,
+**	i.e. every non-W() entry of its row;
+*/
+template<class T, bool Direction, class W>
+template<class Visitor>
+void
+AdjacencyMatrix<T, Direction, W>::forEachAdjacent(const int& srcIndex, Visitor visit) const
+{
+	const std::vector<W>& row = edgeMatrix->at(srcIndex);
+	for(size_t i = 0; i < row.size(); ++i)
+	{
+		if(row[i] != W())
+			visit(static_cast<int>(i), row[i]);
+	}
+}
+
+template<class T, bool Direction, class W>
+void
+AdjacencyMatrix<T, Direction, W>::addVertex(const T& vertex)
+{
+	GRAPH_TIME_SCOPE(addVertex);
+	pathScratch.invalidate();
+	vertexArray->push_back(vertex);
+	for(auto &i : *edgeMatrix)
+	{
+		i.push_back(W());
+	}
+	edgeMatrix->push_back(std::vector<W>(vertexArray->size(), W()));
+}
+
+template<class T, bool Direction, class W>
+void
+AdjacencyMatrix<T, Direction, W>::eraseVertex(const T& vertexToDelete)
+{
+	GRAPH_TIME_SCOPE(eraseVertex);
+	pathScratch.invalidate();
+	int toDeleteIndex = LocateVertexIndex(vertexToDelete);
+	if(toDeleteIndex == -1) return;
+	for(size_t i = 0; i < vertexArray->size(); ++i)
+	{
+		if(edgeMatrix->at(toDeleteIndex).at(i) != W())
+			--edgeCount;
+		if(Direction && static_cast<int>(i) != toDeleteIndex && edgeMatrix->at(i).at(toDeleteIndex) != W())
+			--edgeCount;
+	}
+	vertexArray->erase(vertexArray->begin() + toDeleteIndex);
+	edgeMatrix->erase(edgeMatrix->begin() + toDeleteIndex);
+	for(auto &i : *edgeMatrix)
+	{
+		i.erase(i.begin() + toDeleteIndex);
+	}
+}
+
 template<class T, bool Direction, class W>
 void
 AdjacencyMatrix<T, Direction, W>::addEdge(const T& srcVertex, const T& dstVertex, const W& weight)
 {
+	GRAPH_TIME_SCOPE(addEdge);
+	pathScratch.invalidate();
 	int srcIndex = LocateVertexIndex(srcVertex);
 	int dstIndex = LocateVertexIndex(dstVertex);
 	if(srcIndex == -1 || dstIndex == -1) return;
-	edgeMatrix->at(srcIndex).at(dstIndex) = weight;
-	++edgeCount;
+	// one cell per pair: overwriting an edge does not count it again
+	W& slot = edgeMatrix->at(srcIndex).at(dstIndex);
+	if(slot == W() && weight != W())
+		++edgeCount;
+	else if(slot != W() && weight == W())
+		--edgeCount;
+	slot = weight;
 	if(!Direction)
 		edgeMatrix->at(dstIndex).at(srcIndex) = weight;
 }
@@ -174,9 +267,12 @@ template<class T, bool Direction, class W>
 void
 AdjacencyMatrix<T, Direction, W>::eraseEdge(const T& srcVertex, const T& dstVertex)
 {
+	GRAPH_TIME_SCOPE(eraseEdge);
+	pathScratch.invalidate();
 	int srcIndex = LocateVertexIndex(srcVertex);
 	int dstIndex = LocateVertexIndex(dstVertex);
 	if(srcIndex == -1 || dstIndex == -1) return;
+	if(edgeMatrix->at(srcIndex).at(dstIndex) == W()) return;
 	edgeMatrix->at(srcIndex).at(dstIndex) = W();
 	--edgeCount;
 	if(!Direction)
@@ -187,11 +283,16 @@ template<class T, bool Direction, class W>
 int
 AdjacencyMatrix<T, Direction, W>::LocateVertexIndex(const T& vertex) const
 {
+	GRAPH_COUNT(locateVertexCalls, 1);
 	for(size_t i = 0; i < vertexArray->size(); ++i)
 	{
 		if(vertexArray->at(i) == vertex)
+		{
+			GRAPH_COUNT(locateVertexScan, i + 1);
 			return i;
+		}
 	}
+	GRAPH_COUNT(locateVertexScan, vertexArray->size());
 	return -1;
 }
 
@@ -199,6 +300,7 @@ template<class T, bool Direction, class W>
 void
 AdjacencyMatrix<T, Direction, W>::DFS(const T& srcVertex) const
 {
+	GRAPH_TIME_SCOPE(DFS);
 	int srcIndex = LocateVertexIndex(srcVertex);
 	if(srcIndex == -1) return;
 	std::vector<int> visited(vertexArray->size(), false);
@@ -211,6 +313,7 @@ template<class T, bool Direction, class W>
 void
 AdjacencyMatrix<T, Direction, W>::DFS() const
 {
+	GRAPH_TIME_SCOPE(DFS);
 	std::vector<int> visited(vertexArray->size(), false);
 	std::cout << "DFS: ";
 	DFS(0, visited);
@@ -221,6 +324,8 @@ template<class T, bool Direction, class W>
 void
 AdjacencyMatrix<T, Direction, W>::DFS(size_t srcIndex, std::vector<int>& visited) const
 {
+	GRAPH_COUNT(dfsVertices, 1);
+	GRAPH_COUNT(dfsEdges, vertexArray->size());
 	std::cout << vertexArray->at(srcIndex) << " ";
 	visited[srcIndex] = true;
 	for(size_t i = 0; i < vertexArray->size(); ++i)
@@ -234,6 +339,7 @@ template<class T, bool Direction, class W>
 void
 AdjacencyMatrix<T, Direction, W>::DFSInConnectedComponents() const
 {
+	GRAPH_TIME_SCOPE(DFSInConnectedComponents);
 	std::vector<int> visited(vertexArray->size(), false);
 	std::cout << "DFS in Connected Components: ";
 	for(size_t i = 0; i < vertexArray->size(); ++i)
@@ -249,6 +355,7 @@ template<class T, bool Direction, class W>
 void
 AdjacencyMatrix<T, Direction, W>::BFS(const T& srcVertex) const
 {
+	GRAPH_TIME_SCOPE(BFS);
 	int srcIndex = LocateVertexIndex(srcVertex);
 	if(srcIndex == -1) return;
 	std::vector<int> visited(vertexArray->size(), false);
@@ -259,6 +366,8 @@ AdjacencyMatrix<T, Direction, W>::BFS(const T& srcVertex) const
 	while(!q.empty())
 	{
 		int front = q.front();
+		GRAPH_COUNT(bfsVertices, 1);
+		GRAPH_COUNT(bfsEdges, vertexArray->size());
 		std::cout << vertexArray->at(front) << " ";
 		q.pop();
 		for(size_t i = 0; i < vertexArray->size(); ++i)
@@ -277,6 +386,7 @@ template<class T, bool Direction, class W>
 void
 AdjacencyMatrix<T, Direction, W>::BFS() const
 {
+	GRAPH_TIME_SCOPE(BFS);
 	std::vector<int> visited(vertexArray->size(), false);
 	std::queue<int> q;
 	q.push(0);
@@ -285,6 +395,8 @@ AdjacencyMatrix<T, Direction, W>::BFS() const
 	while(!q.empty())
 	{
 		int front = q.front();
+		GRAPH_COUNT(bfsVertices, 1);
+		GRAPH_COUNT(bfsEdges, vertexArray->size());
 		std::cout << vertexArray->at(front) << " ";
 		q.pop();
 		for(size_t i = 0; i < vertexArray->size(); ++i)
@@ -303,6 +415,7 @@ template<class T, bool Direction, class W>
 void 
 AdjacencyMatrix<T, Direction, W>::BFSInConnectedComponents() const
 {
+	GRAPH_TIME_SCOPE(BFSInConnectedComponents);
 	std::vector<int> visited(vertexArray->size(), false);
 	std::cout << "BFS in Connected Components: ";
 	for(size_t i = 0; i < vertexArray->size(); ++i)
@@ -323,6 +436,8 @@ AdjacencyMatrix<T, Direction, W>::BFSInConnectedComponents(size_t srcIndex, std:
 	while(!q.empty())
 	{
 		int front = q.front();
+		GRAPH_COUNT(bfsVertices, 1);
+		GRAPH_COUNT(bfsEdges, vertexArray->size());
 		std::cout << vertexArray->at(front) << " ";
 		q.pop();
 		for(size_t i = 0; i < vertexArray->size(); ++i)
@@ -340,6 +455,7 @@ template<class T, bool Direction, class W>
 void
 AdjacencyMatrix<T, Direction, W>::printMatrix() const
 {
+	GRAPH_TIME_SCOPE(printMatrix);
 	for(size_t i = 0; i < edgeMatrix->size(); ++i)
 	{
 		for(size_t j = 0; j < edgeMatrix->at(i).size(); ++j)
@@ -354,6 +470,7 @@ template<class T, bool Direction, class W>
 void
 AdjacencyMatrix<T, Direction, W>::clear()
 {
+	GRAPH_TIME_SCOPE(clear);
 	if(vertexArray != nullptr)
 	{
 		delete vertexArray;
@@ -371,6 +488,7 @@ template<class T, bool Direction, class W>
 void 
 AdjacencyMatrix<T, Direction, W>::dijkstraPath(T srcVertex)
 {
+	GRAPH_TIME_SCOPE(dijkstraPath);
 	std::vector<W> distance(vertexArray->size(), std::numeric_limits<W>::max());
 	std::vector<T> prevVertex(vertexArray->size(), T());
 	std::priority_queue<DijkstraNode<T, W>, std::vector<DijkstraNode<T, W>>, DijkstraNodeComparator<T, W>> unVisited;
@@ -384,12 +502,14 @@ AdjacencyMatrix<T, Direction, W>::dijkstraPath(T srcVertex)
 	{
 		DijkstraNode<T, W> current = unVisited.top();
 		unVisited.pop();
+		// read the row directly: the public isEdge would be timed and rescan the vertexs per cell
+		int currentIndex = LocateVertexIndex(current.currentVertex);
 		for(int i = 0; i < vertexArray->size(); ++i)
 		{
-			if(isEdge(current.currentVertex, vertexArray->at(i)))
+			if(edgeMatrix->at(currentIndex).at(i) != W())
 			{
-				W edgeWeight = edgeMatrix->at(LocateVertexIndex(current.currentVertex)).at(i);
-				W alternativePathDistance = distance.at(LocateVertexIndex(current.currentVertex)) + edgeWeight;
+				W edgeWeight = edgeMatrix->at(currentIndex).at(i);
+				W alternativePathDistance = distance.at(currentIndex) + edgeWeight;
 				if(alternativePathDistance < distance[i])
 				{
 					distance.at(i) = alternativePathDistance;
@@ -406,4 +526,25 @@ AdjacencyMatrix<T, Direction, W>::dijkstraPath(T srcVertex)
 
 }
 
+template<class T, bool Direction, class W>
+std::vector<T>
+AdjacencyMatrix<T, Direction, W>::shortestPath(const T& srcVertex, const T& dstVertex)
+{
+	GRAPH_TIME_SCOPE(shortestPath);
+	return ::bidirectionalDijkstraPath(*this, pathScratch, srcVertex, dstVertex);
+}
+
+/*
+**	heuristic(vertex, dstVertex) estimates the remaining distance and must
+**	not overestimate it;
+*/
+template<class T, bool Direction, class W>
+template<class Heuristic>
+std::vector<T>
+AdjacencyMatrix<T, Direction, W>::aStarPath(const T& srcVertex, const T& dstVertex, Heuristic heuristic)
+{
+	GRAPH_TIME_SCOPE(aStarPath);
+	return ::aStarPath(*this, pathScratch, srcVertex, dstVertex, heuristic);
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,524 @@
+/***********************************************************************
+** Date: 		10/19/26
+** Project :	compressed_adjacency_list.h
+** Programers:	Jiahao Liang
+** File:		compressed_adjacency_list.h
+** Purpose:		Read-only, compressed copy of an AdjacencyList
+** Notes:		Each vertex's neighbours are sorted and written into one byte
+**				stream as LEB128 varints: the first as a zigzag offset from
+**				the vertex itself, the rest as gaps from the previous one.
+**				Every id is followed by its weight, stored as StoredW. When W
+**				is floating point and StoredW an integer (e.g. uint8_t), weights
+**				are linearly quantized over [min, max]. Neighbours are decoded
+**				on the fly by NeighbourIterator and forEachAdjacent, so the
+**				generic algorithms (MultiSourceBFS, path search, ...) run on it
+**				unchanged. Built from an IdentityVertexMap list it keeps no
+**				vertex table at all, as the source does not either.
+***********************************************************************/
+
+#pragma once
+#ifndef _COMPRESSED_ADJACENCY_LIST_H_
+#define _COMPRESSED_ADJACENCY_LIST_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "adjacency_list.h"
+#include "identity_vertex_map.h"
+
+/*
+**	The vertex values of a CompressedAdjacencyList by index; a copy of the
+**	source's vertex table, looked up by a linear scan like LocateVertexIndex;
+*/
+template<class T>
+class CompressedVertexTable
+{
+public:
+	template<class Graph>
+	CompressedVertexTable(const Graph& graph)
+	:	vertexs(graph.getVertexCount())
+	{
+		for(size_t i = 0; i < vertexs.size(); ++i)
+			vertexs[i] = graph.getVertex(i);
+	}
+	const T& get(const int& index) const
+	{
+		return vertexs.at(index);
+	}
+	int indexOf(const T& vertex) const
+	{
+		for(size_t i = 0; i < vertexs.size(); ++i)
+		{
+			if(vertexs[i] == vertex)
+				return i;
+		}
+		return -1;
+	}
+	size_t getByteSize() const
+	{
+		return vertexs.capacity() * sizeof(T);
+	}
+private:
+	std::vector<T> vertexs;
+};
+
+/*
+**	Under IdentityVertexMap a vertex is its own index, so there is nothing
+**	to store and a lookup is a bounds check;
+*/
+template<class Index>
+class CompressedVertexTable<IdentityVertexMap<Index>>
+{
+public:
+	template<class Graph>
+	CompressedVertexTable(const Graph& graph)
+	:	vertexCount(graph.getVertexCount())
+	{}
+	Index get(const int& index) const
+	{
+		return static_cast<Index>(index);
+	}
+	int indexOf(const Index& vertex) const
+	{
+		return vertex >= Index() && static_cast<size_t>(vertex) < vertexCount ? static_cast<int>(vertex) : -1;
+	}
+	size_t getByteSize() const
+	{
+		return 0;
+	}
+private:
+	size_t vertexCount;
+};
+
+/*
+**	T, Direction, W as in the AdjacencyList it is built from;
+**	StoredW for the weight as stored, e.g. float for double or uint8_t
+**	to quantize to 256 levels; an integer W is never narrowed, so StoredW
+**	must then hold its whole range;
+*/
+template<class T, bool Direction=false, class W=int, class StoredW=W>
+class CompressedAdjacencyList
+{
+public:
+	typedef typename AdjacencyList<T, Direction, W>::VertexType VertexType;
+	typedef W WeightType;
+
+	class NeighbourIterator
+	{
+	public:
+		friend class CompressedAdjacencyList;
+	public:
+		int operator*() const
+		{
+			return index;
+		}
+		const W& weight() const
+		{
+			return currentWeight;
+		}
+		NeighbourIterator& operator++()
+		{
+			if(position == end)
+				position = nullptr;
+			else
+				decode(index + static_cast<int>(CompressedAdjacencyList::readVarint(position)));
+			return *this;
+		}
+		bool operator==(const NeighbourIterator& another) const
+		{
+			return position == another.position;
+		}
+		bool operator!=(const NeighbourIterator& another) const
+		{
+			return position != another.position;
+		}
+	private:
+		NeighbourIterator(const CompressedAdjacencyList* graph, const uint8_t* position, const uint8_t* end, const int& srcIndex)
+		:	graph(graph)
+		,	position(position == end ? nullptr : position)
+		,	end(end)
+		,	index(0)
+		{
+			if(this->position != nullptr)
+				decode(srcIndex + CompressedAdjacencyList::unzigzag(CompressedAdjacencyList::readVarint(this->position)));
+		}
+		void decode(const int& nextIndex)
+		{
+			StoredW stored;
+			std::memcpy(&stored, position, sizeof(StoredW));
+			position += sizeof(StoredW);
+			index = nextIndex;
+			currentWeight = graph->decodeWeight(stored);
+		}
+	private:
+		const CompressedAdjacencyList* graph;
+		const uint8_t* position; // just past the current neighbour, nullptr once exhausted
+		const uint8_t* end;
+		int index;
+		W currentWeight;
+	};
+
+	class NeighbourRange
+	{
+	public:
+		NeighbourRange(const NeighbourIterator& first, const NeighbourIterator& last)
+		:	first(first)
+		,	last(last)
+		{}
+		NeighbourIterator begin() const
+		{
+			return first;
+		}
+		NeighbourIterator end() const
+		{
+			return last;
+		}
+	private:
+		NeighbourIterator first;
+		NeighbourIterator last;
+	};
+
+public:
+	CompressedAdjacencyList(const AdjacencyList<T, Direction, W>& graph);
+	int getVertexCount() const;
+	int getEdgeCount() const;
+	bool isDirected() const;
+	size_t getByteSize() const;
+	bool isEdge(const VertexType& srcVertex, const VertexType& dstVertex) const;
+	VertexType getVertex(const int& index) const;
+	int getVertexIndex(const VertexType& vertex) const;
+	NeighbourRange neighbours(const int& srcIndex) const;
+	template<class Visitor>
+	void forEachAdjacent(const int& srcIndex, Visitor visit) const;
+	void DFS(const VertexType& srcVertex) const;
+	void DFS() const;
+	void DFSInConnectedComponents() const;
+	void BFS(const VertexType& srcVertex) const;
+	void BFS() const;
+	void BFSInConnectedComponents() const;
+
+private:
+	static const bool quantized = std::is_floating_point<W>::value && std::is_integral<StoredW>::value;
+	static const bool widening = std::numeric_limits<StoredW>::digits >= std::numeric_limits<W>::digits
+		&& (std::is_signed<StoredW>::value || !std::is_signed<W>::value);
+	static_assert(quantized || widening || (std::is_floating_point<W>::value && std::is_floating_point<StoredW>::value),
+		"StoredW must hold every W value unless W is floating point (quantized or rounded)");
+	static void writeVarint(std::vector<uint8_t>& out, uint64_t value);
+	static uint64_t readVarint(const uint8_t*& in);
+	static uint64_t zigzag(const int64_t& value);
+	static int64_t unzigzag(const uint64_t& value);
+	StoredW encodeWeight(const W& weight) const;
+	W decodeWeight(const StoredW& stored) const;
+	void DFS(std::vector<int>& visited, size_t srcIndex) const;
+	void BFS(std::vector<int>& visited, size_t srcIndex) const;
+
+private:
+	CompressedVertexTable<T> vertexs;
+	std::vector<uint64_t> offset;	// the neighbours of vertex i are bytes[offset[i], offset[i+1])
+	std::vector<uint8_t> bytes;
+	int edgeCount;
+	W weightBase;					// decoded weight = weightBase + stored * weightScale when quantized
+	W weightScale;
+};
+
+template<class T, bool Direction, class W, class StoredW>
+CompressedAdjacencyList<T, Direction, W, StoredW>::CompressedAdjacencyList(const AdjacencyList<T, Direction, W>& graph)
+:	vertexs(graph)
+,	offset(graph.getVertexCount() + 1, 0)
+,	edgeCount(graph.getEdgeCount())
+,	weightBase(W())
+,	weightScale(W(1))
+{
+	if(quantized)
+	{
+		bool first = true;
+		W minWeight = W(), maxWeight = W();
+		for(int i = 0; i < graph.getVertexCount(); ++i)
+		{
+			graph.forEachAdjacent(i, [&](const int&, const W& weight)
+			{
+				minWeight = first || weight < minWeight ? weight : minWeight;
+				maxWeight = first || weight > maxWeight ? weight : maxWeight;
+				first = false;
+			});
+		}
+		weightBase = minWeight;
+		weightScale = (maxWeight - minWeight) / static_cast<W>(std::numeric_limits<StoredW>::max());
+	}
+
+	std::vector<std::pair<int, W>> adjacent;
+	for(int i = 0; i < graph.getVertexCount(); ++i)
+	{
+		adjacent.clear();
+		graph.forEachAdjacent(i, [&](const int& j, const W& weight)
+		{
+			adjacent.push_back(std::make_pair(j, weight));
+		});
+		std::sort(adjacent.begin(), adjacent.end(), [](const std::pair<int, W>& a, const std::pair<int, W>& b)
+		{
+			return a.first < b.first;
+		});
+		for(size_t j = 0; j < adjacent.size(); ++j)
+		{
+			if(j == 0)
+				writeVarint(bytes, zigzag(static_cast<int64_t>(adjacent[j].first) - i));
+			else
+				writeVarint(bytes, adjacent[j].first - adjacent[j - 1].first);
+			StoredW stored = encodeWeight(adjacent[j].second);
+			uint8_t raw[sizeof(StoredW)];
+			std::memcpy(raw, &stored, sizeof(StoredW));
+			bytes.insert(bytes.end(), raw, raw + sizeof(StoredW));
+		}
+		offset[i + 1] = bytes.size();
+	}
+	bytes.shrink_to_fit();
+}
+
+template<class T, bool Direction, class W, class StoredW>
+void
+CompressedAdjacencyList<T, Direction, W, StoredW>::writeVarint(std::vector<uint8_t>& out, uint64_t value)
+{
+	while(value >= 0x80)
+	{
+		out.push_back(static_cast<uint8_t>(value) | 0x80);
+		value >>= 7;
+	}
+	out.push_back(static_cast<uint8_t>(value));
+}
+
+template<class T, bool Direction, class W, class StoredW>
+uint64_t
+CompressedAdjacencyList<T, Direction, W, StoredW>::readVarint(const uint8_t*& in)
+{
+	uint64_t value = *in & 0x7f;
+	for(int shift = 7; *in++ & 0x80; shift += 7)
+		value |= static_cast<uint64_t>(*in & 0x7f) << shift;
+	return value;
+}
+
+template<class T, bool Direction, class W, class StoredW>
+uint64_t
+CompressedAdjacencyList<T, Direction, W, StoredW>::zigzag(const int64_t& value)
+{
+	return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+template<class T, bool Direction, class W, class StoredW>
+int64_t
+CompressedAdjacencyList<T, Direction, W, StoredW>::unzigzag(const uint64_t& value)
+{
+	return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+template<class T, bool Direction, class W, class StoredW>
+StoredW
+CompressedAdjacencyList<T, Direction, W, StoredW>::encodeWeight(const W& weight) const
+{
+	if(!quantized || weightScale == W())
+		return static_cast<StoredW>(quantized ? W() : weight);
+	return static_cast<StoredW>(std::lround((weight - weightBase) / weightScale));
+}
+
+template<class T, bool Direction, class W, class StoredW>
+W
+CompressedAdjacencyList<T, Direction, W, StoredW>::decodeWeight(const StoredW& stored) const
+{
+	if(!quantized)
+		return static_cast<W>(stored);
+	return weightBase + static_cast<W>(stored) * weightScale;
+}
+
+template<class T, bool Direction, class W, class StoredW>
+int
+CompressedAdjacencyList<T, Direction, W, StoredW>::getVertexCount() const
+{
+	return offset.size() - 1;
+}
+
+template<class T, bool Direction, class W, class StoredW>
+int
+CompressedAdjacencyList<T, Direction, W, StoredW>::getEdgeCount() const
+{
+	return edgeCount;
+}
+
+template<class T, bool Direction, class W, class StoredW>
+bool
+CompressedAdjacencyList<T, Direction, W, StoredW>::isDirected() const
+{
+	return Direction;
+}
+
+template<class T, bool Direction, class W, class StoredW>
+size_t
+CompressedAdjacencyList<T, Direction, W, StoredW>::getByteSize() const
+{
+	return bytes.capacity() + offset.capacity() * sizeof(uint64_t) + vertexs.getByteSize();
+}
+
+template<class T, bool Direction, class W, class StoredW>
+bool
+CompressedAdjacencyList<T, Direction, W, StoredW>::isEdge(const VertexType& srcVertex, const VertexType& dstVertex) const
+{
+	int srcIndex = getVertexIndex(srcVertex);
+	int dstIndex = getVertexIndex(dstVertex);
+	if(srcIndex == -1 || dstIndex == -1) return false;
+	for(const auto &i : neighbours(srcIndex))
+	{
+		if(i >= dstIndex)
+			return i == dstIndex;
+	}
+	return false;
+}
+
+template<class T, bool Direction, class W, class StoredW>
+typename CompressedAdjacencyList<T, Direction, W, StoredW>::VertexType
+CompressedAdjacencyList<T, Direction, W, StoredW>::getVertex(const int& index) const
+{
+	return vertexs.get(index);
+}
+
+template<class T, bool Direction, class W, class StoredW>
+int
+CompressedAdjacencyList<T, Direction, W, StoredW>::getVertexIndex(const VertexType& vertex) const
+{
+	return vertexs.indexOf(vertex);
+}
+
+template<class T, bool Direction, class W, class StoredW>
+typename CompressedAdjacencyList<T, Direction, W, StoredW>::NeighbourRange
+CompressedAdjacencyList<T, Direction, W, StoredW>::neighbours(const int& srcIndex) const
+{
+	const uint8_t* first = bytes.data() + offset.at(srcIndex);
+	const uint8_t* last = bytes.data() + offset.at(srcIndex + 1);
+	return NeighbourRange(NeighbourIterator(this, first, last, srcIndex), NeighbourIterator(this, last, last, srcIndex));
+}
+
+template<class T, bool Direction, class W, class StoredW>
+template<class Visitor>
+void
+CompressedAdjacencyList<T, Direction, W, StoredW>::forEachAdjacent(const int& srcIndex, Visitor visit) const
+{
+	NeighbourRange range = neighbours(srcIndex);
+	for(NeighbourIterator i = range.begin(); i != range.end(); ++i)
+		visit(*i, i.weight());
+}
+
+template<class T, bool Direction, class W, class StoredW>
+void
+CompressedAdjacencyList<T, Direction, W, StoredW>::DFS(const VertexType& srcVertex) const
+{
+	int srcIndex = getVertexIndex(srcVertex);
+	if(srcIndex == -1) return;
+	std::vector<int> visited(getVertexCount(), false);
+	std::cout << "DFS: ";
+	DFS(visited, srcIndex);
+	std::cout << "\n";
+}
+
+template<class T, bool Direction, class W, class StoredW>
+void
+CompressedAdjacencyList<T, Direction, W, StoredW>::DFS() const
+{
+	if(getVertexCount() == 0) return;
+	std::vector<int> visited(getVertexCount(), false);
+	std::cout << "DFS: ";
+	DFS(visited, 0);
+	std::cout << "\n";
+}
+
+template<class T, bool Direction, class W, class StoredW>
+void
+CompressedAdjacencyList<T, Direction, W, StoredW>::DFSInConnectedComponents() const
+{
+	std::vector<int> visited(getVertexCount(), false);
+	std::cout << "DFS in Connected Components: ";
+	for(int i = 0; i < getVertexCount(); ++i)
+	{
+		if(visited[i] == false)
+			DFS(visited, i);
+	}
+	std::cout << "\n";
+}
+
+template<class T, bool Direction, class W, class StoredW>
+void
+CompressedAdjacencyList<T, Direction, W, StoredW>::DFS(std::vector<int>& visited, size_t srcIndex) const
+{
+	std::cout << getVertex(srcIndex) << " ";
+	visited[srcIndex] = true;
+	for(const auto &i : neighbours(srcIndex))
+	{
+		if(visited[i] == false)
+			DFS(visited, i);
+	}
+}
+
+template<class T, bool Direction, class W, class StoredW>
+void
+CompressedAdjacencyList<T, Direction, W, StoredW>::BFS(const VertexType& srcVertex) const
+{
+	int srcIndex = getVertexIndex(srcVertex);
+	if(srcIndex == -1) return;
+	std::vector<int> visited(getVertexCount(), false);
+	std::cout << "BFS: ";
+	BFS(visited, srcIndex);
+	std::cout << "\n";
+}
+
+template<class T, bool Direction, class W, class StoredW>
+void
+CompressedAdjacencyList<T, Direction, W, StoredW>::BFS() const
+{
+	if(getVertexCount() == 0) return;
+	std::vector<int> visited(getVertexCount(), false);
+	std::cout << "BFS: ";
+	BFS(visited, 0);
+	std::cout << "\n";
+}
+
+template<class T, bool Direction, class W, class StoredW>
+void
+CompressedAdjacencyList<T, Direction, W, StoredW>::BFSInConnectedComponents() const
+{
+	std::vector<int> visited(getVertexCount(), false);
+	std::cout << "BFS in Connected Components: ";
+	for(int i = 0; i < getVertexCount(); ++i)
+	{
+		if(visited[i] == false)
+			BFS(visited, i);
+	}
+	std::cout << "\n";
+}
+
+template<class T, bool Direction, class W, class StoredW>
+void
+CompressedAdjacencyList<T, Direction, W, StoredW>::BFS(std::vector<int>& visited, size_t srcIndex) const
+{
+	std::queue<int> q;
+	q.push(srcIndex);
+	visited[srcIndex] = true;
+	while(!q.empty())
+	{
+		int front = q.front();
+		q.pop();
+		std::cout << getVertex(front) << " ";
+		for(const auto &i : neighbours(front))
+		{
+			if(visited[i] == false)
+			{
+				q.push(i);
+				visited[i] = true;
+			}
+		}
+	}
+}
+
+#endif
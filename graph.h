@@ -0,0 +1,419 @@
+/***********************************************************************
+** Date: 		10/19/26
+** Project :	graph.h
+** Programers:	Jiahao Liang
+** File:		graph.h
+** Purpose:		The class Graph, a facade over AdjacencyList and AdjacencyMatrix
+**				that picks the storage by edge density
+** Notes:		The graph starts sparse (AdjacencyList). Once density reaches
+**				denseThreshold it is rebuilt as an AdjacencyMatrix, and once it
+**				falls to sparseThreshold it goes back to a list. Keep the two
+**				thresholds apart so a graph near the boundary does not rebuild
+**				on every edge. The matrix uses W() to mean "no edge" and holds
+**				one edge per pair, so addEdge() ignores a W() weight and
+**				overwrites the weight of an existing edge in either layout.
+***********************************************************************/
+
+#pragma once
+#ifndef _GRAPH_H_
+#define _GRAPH_H_
+
+#include <iostream>
+#include <utility>
+#include <vector>
+#include "adjacency_list.h"
+#include "adjacency_matrix.h"
+
+/*
+**	T for valueType;
+**	Direction=false for undirected graphs and vice versa for directed graphs;
+**	W for weightType of edge;
+**	density = edges / possible edges, without self-loops;
+*/
+template<class T, bool Direction=false, class W=int>
+class Graph
+{
+public:
+	typedef T VertexType;
+	typedef W WeightType;
+
+public:
+	Graph(const std::vector<T>& vertexs, const double& denseThreshold = 0.25, const double& sparseThreshold = 0.125);
+	Graph(const Graph<T, Direction, W>& another);
+	~Graph();
+	Graph& operator=(Graph<T, Direction, W> another);
+	int getVertexCount() const;
+	int getEdgeCount() const;
+	bool isDirected() const;
+	bool isDense() const;
+	double getDensity() const;
+	bool isEdge(const T& srcVertex, const T& dstVertex) const;
+	const T& getVertex(const int& index) const;
+	int getVertexIndex(const T& vertex) const;
+	template<class Visitor>
+	void forEachAdjacent(const int& srcIndex, Visitor visit) const;
+	void addVertex(const T& vertex);
+	void eraseVertex(const T& vertexToDelete);
+	void addEdge(const T& srcVertex, const T& dstVertex, const W& weight = 1);
+	void eraseEdge(const T& srcVertex, const T& dstVertex);
+	void DFS(const T& srcVertex) const;
+	void DFS() const;
+	void DFSInConnectedComponents() const;
+	void BFS(const T& srcVertex) const;
+	void BFS() const;
+	void BFSInConnectedComponents() const;
+	std::vector<T> shortestPath(const T& srcVertex, const T& dstVertex);
+	template<class Heuristic>
+	std::vector<T> aStarPath(const T& srcVertex, const T& dstVertex, Heuristic heuristic);
+	void clear();
+
+private:
+	std::vector<T> getVertexs() const;
+	void rebalance();
+	void toDense();
+	void toSparse();
+
+private:
+	AdjacencyList<T, Direction, W>* sparse;
+	AdjacencyMatrix<T, Direction, W>* dense; // exactly one of sparse and dense is non-null
+	double denseThreshold;
+	double sparseThreshold;
+};
+
+template<class T, bool Direction, class W>
+Graph<T, Direction, W>::Graph(const std::vector<T>& vertexs, const double& denseThreshold, const double& sparseThreshold)
+:	sparse(new AdjacencyList<T, Direction, W>(vertexs))
+,	dense(nullptr)
+,	denseThreshold(denseThreshold)
+,	sparseThreshold(sparseThreshold)
+{}
+
+template<class T, bool Direction, class W>
+Graph<T, Direction, W>::Graph(const Graph& another)
+:	sparse(new AdjacencyList<T, Direction, W>(another.getVertexs()))
+,	dense(nullptr)
+,	denseThreshold(another.denseThreshold)
+,	sparseThreshold(another.sparseThreshold)
+{
+	for(int i = 0; i < another.getVertexCount(); ++i)
+	{
+		another.forEachAdjacent(i, [&](const int& j, const W& weight)
+		{
+			sparse->addEdgeNode(i, j, weight);
+		});
+	}
+	sparse->edgeCount = another.getEdgeCount();
+	if(another.isDense())
+		toDense();
+}
+
+template<class T, bool Direction, class W>
+Graph<T, Direction, W>::~Graph()
+{
+	clear();
+}
+
+/*
+**	Copy-and-swap: another is already a deep copy made by the copy
+**	constructor, and takes the old storage with it when it goes away;
+*/
+template<class T, bool Direction, class W>
+Graph<T, Direction, W>&
+Graph<T, Direction, W>::operator=(Graph another)
+{
+	std::swap(sparse, another.sparse);
+	std::swap(dense, another.dense);
+	std::swap(denseThreshold, another.denseThreshold);
+	std::swap(sparseThreshold, another.sparseThreshold);
+	return *this;
+}
+
+template<class T, bool Direction, class W>
+int
+Graph<T, Direction, W>::getVertexCount() const
+{
+	return sparse != nullptr ? sparse->getVertexCount() : dense->getVertexCount();
+}
+
+template<class T, bool Direction, class W>
+int
+Graph<T, Direction, W>::getEdgeCount() const
+{
+	return sparse != nullptr ? sparse->getEdgeCount() : dense->getEdgeCount();
+}
+
+template<class T, bool Direction, class W>
+bool
+Graph<T, Direction, W>::isDirected() const
+{
+	return Direction;
+}
+
+template<class T, bool Direction, class W>
+bool
+Graph<T, Direction, W>::isDense() const
+{
+	return dense != nullptr;
+}
+
+template<class T, bool Direction, class W>
+double
+Graph<T, Direction, W>::getDensity() const
+{
+	double vertexCount = getVertexCount();
+	if(vertexCount < 2)
+		return 0;
+	double possibleEdges = vertexCount * (vertexCount - 1);
+	if(!Direction)
+		possibleEdges /= 2;
+	return getEdgeCount() / possibleEdges;
+}
+
+template<class T, bool Direction, class W>
+bool
+Graph<T, Direction, W>::isEdge(const T& srcVertex, const T& dstVertex) const
+{
+	return sparse != nullptr ? sparse->isEdge(srcVertex, dstVertex) : dense->isEdge(srcVertex, dstVertex);
+}
+
+template<class T, bool Direction, class W>
+const T&
+Graph<T, Direction, W>::getVertex(const int& index) const
+{
+	return sparse != nullptr ? sparse->getVertex(index) : dense->getVertex(index);
+}
+
+template<class T, bool Direction, class W>
+int
+Graph<T, Direction, W>::getVertexIndex(const T& vertex) const
+{
+	return sparse != nullptr ? sparse->getVertexIndex(vertex) : dense->getVertexIndex(vertex);
+}
+
+template<class T, bool Direction, class W>
+template<class Visitor>
+void
+Graph<T, Direction, W>::forEachAdjacent(const int& srcIndex, Visitor visit) const
+{
+	if(sparse != nullptr)
+		sparse->forEachAdjacent(srcIndex, visit);
+	else
+		dense->forEachAdjacent(srcIndex, visit);
+}
+
+template<class T, bool Direction, class W>
+void
+Graph<T, Direction, W>::addVertex(const T& vertex)
+{
+	if(sparse != nullptr)
+		sparse->addVertex(vertex);
+	else
+		dense->addVertex(vertex);
+	rebalance();
+}
+
+template<class T, bool Direction, class W>
+void
+Graph<T, Direction, W>::eraseVertex(const T& vertexToDelete)
+{
+	if(sparse != nullptr)
+		sparse->eraseVertex(vertexToDelete);
+	else
+		dense->eraseVertex(vertexToDelete);
+	rebalance();
+}
+
+template<class T, bool Direction, class W>
+void
+Graph<T, Direction, W>::addEdge(const T& srcVertex, const T& dstVertex, const W& weight)
+{
+	// the matrix reads W() as "no edge", so neither layout may store one
+	if(weight == W()) return;
+	if(isEdge(srcVertex, dstVertex))
+	{
+		// overwrite the weight without counting the edge twice
+		if(sparse != nullptr)
+			sparse->eraseEdge(srcVertex, dstVertex);
+		else
+			dense->eraseEdge(srcVertex, dstVertex);
+	}
+	if(sparse != nullptr)
+		sparse->addEdge(srcVertex, dstVertex, weight);
+	else
+		dense->addEdge(srcVertex, dstVertex, weight);
+	rebalance();
+}
+
+template<class T, bool Direction, class W>
+void
+Graph<T, Direction, W>::eraseEdge(const T& srcVertex, const T& dstVertex)
+{
+	if(!isEdge(srcVertex, dstVertex)) return;
+	if(sparse != nullptr)
+		sparse->eraseEdge(srcVertex, dstVertex);
+	else
+		dense->eraseEdge(srcVertex, dstVertex);
+	rebalance();
+}
+
+template<class T, bool Direction, class W>
+void
+Graph<T, Direction, W>::DFS(const T& srcVertex) const
+{
+	if(sparse != nullptr)
+		sparse->DFS(srcVertex);
+	else
+		dense->DFS(srcVertex);
+}
+
+template<class T, bool Direction, class W>
+void
+Graph<T, Direction, W>::DFS() const
+{
+	if(sparse != nullptr)
+		sparse->DFS();
+	else
+		dense->DFS();
+}
+
+template<class T, bool Direction, class W>
+void
+Graph<T, Direction, W>::DFSInConnectedComponents() const
+{
+	if(sparse != nullptr)
+		sparse->DFSInConnectedComponents();
+	else
+		dense->DFSInConnectedComponents();
+}
+
+template<class T, bool Direction, class W>
+void
+Graph<T, Direction, W>::BFS(const T& srcVertex) const
+{
+	if(sparse != nullptr)
+		sparse->BFS(srcVertex);
+	else
+		dense->BFS(srcVertex);
+}
+
+template<class T, bool Direction, class W>
+void
+Graph<T, Direction, W>::BFS() const
+{
+	if(sparse != nullptr)
+		sparse->BFS();
+	else
+		dense->BFS();
+}
+
+template<class T, bool Direction, class W>
+void
+Graph<T, Direction, W>::BFSInConnectedComponents() const
+{
+	if(sparse != nullptr)
+		sparse->BFSInConnectedComponents();
+	else
+		dense->BFSInConnectedComponents();
+}
+
+template<class T, bool Direction, class W>
+std::vector<T>
+Graph<T, Direction, W>::shortestPath(const T& srcVertex, const T& dstVertex)
+{
+	return sparse != nullptr ? sparse->shortestPath(srcVertex, dstVertex) : dense->shortestPath(srcVertex, dstVertex);
+}
+
+template<class T, bool Direction, class W>
+template<class Heuristic>
+std::vector<T>
+Graph<T, Direction, W>::aStarPath(const T& srcVertex, const T& dstVertex, Heuristic heuristic)
+{
+	return sparse != nullptr ? sparse->aStarPath(srcVertex, dstVertex, heuristic) : dense->aStarPath(srcVertex, dstVertex, heuristic);
+}
+
+template<class T, bool Direction, class W>
+std::vector<T>
+Graph<T, Direction, W>::getVertexs() const
+{
+	std::vector<T> vertexs(getVertexCount());
+	for(size_t i = 0; i < vertexs.size(); ++i)
+		vertexs.at(i) = getVertex(i);
+	return vertexs;
+}
+
+template<class T, bool Direction, class W>
+void
+Graph<T, Direction, W>::rebalance()
+{
+	double density = getDensity();
+	if(sparse != nullptr && density >= denseThreshold)
+		toDense();
+	else if(dense != nullptr && density <= sparseThreshold)
+		toSparse();
+}
+
+template<class T, bool Direction, class W>
+void
+Graph<T, Direction, W>::toDense()
+{
+	AdjacencyMatrix<T, Direction, W>* matrix = new AdjacencyMatrix<T, Direction, W>(getVertexs());
+	int edgeCount = 0;
+	for(int i = 0; i < sparse->getVertexCount(); ++i)
+	{
+		sparse->forEachAdjacent(i, [&](const int& j, const W& weight)
+		{
+			if((!Direction && j < i) || weight == W())
+				return;
+			W& slot = matrix->edgeMatrix->at(i).at(j);
+			if(slot == W())
+				++edgeCount;
+			slot = weight;
+			if(!Direction)
+				matrix->edgeMatrix->at(j).at(i) = weight;
+		});
+	}
+	matrix->edgeCount = edgeCount;
+	delete sparse;
+	sparse = nullptr;
+	dense = matrix;
+}
+
+template<class T, bool Direction, class W>
+void
+Graph<T, Direction, W>::toSparse()
+{
+	AdjacencyList<T, Direction, W>* list = new AdjacencyList<T, Direction, W>(getVertexs());
+	for(int i = 0; i < dense->getVertexCount(); ++i)
+	{
+		dense->forEachAdjacent(i, [&](const int& j, const W& weight)
+		{
+			if(!Direction && j < i)
+				return;
+			list->addEdgeNode(i, j, weight);
+			if(!Direction)
+				list->addEdgeNode(j, i, weight);
+		});
+	}
+	list->edgeCount = dense->getEdgeCount();
+	delete dense;
+	dense = nullptr;
+	sparse = list;
+}
+
+template<class T, bool Direction, class W>
+void
+Graph<T, Direction, W>::clear()
+{
+	if(sparse != nullptr)
+	{
+		delete sparse;
+		sparse = nullptr;
+	}
+	if(dense != nullptr)
+	{
+		delete dense;
+		dense = nullptr;
+	}
+}
+
+#endif
@@ -0,0 +1,325 @@
+/***********************************************************************
+** Date: 		10/19/26
+** Project :	graph_instrumentation.h
+** Programers:	Jiahao Liang
+** File:		graph_instrumentation.h
+** Purpose:		Opt-in counters and timing histograms for the graph classes
+** Notes:		Compile with -DGRAPH_INSTRUMENTATION to turn the hooks on.
+**				Without it GRAPH_COUNT and GRAPH_TIME_SCOPE expand to nothing,
+**				so the graph code is unchanged. Each thread writes its own
+**				counter block; snapshot() sums every live and exited thread.
+***********************************************************************/
+
+#pragma once
+#ifndef _GRAPH_INSTRUMENTATION_H_
+#define _GRAPH_INSTRUMENTATION_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+enum class GraphCounter
+{
+	locateVertexCalls,
+	locateVertexScan,		// vertices compared by LocateVertexIndex
+	findEdgeCalls,
+	findEdgeChain,			// EdgeNodes walked by findEdgeNode
+	edgeAllocations,		// EdgeNodes allocated by addEdge
+	dfsVertices,
+	dfsEdges,				// adjacency entries examined by DFS
+	bfsVertices,
+	bfsEdges,				// adjacency entries examined by BFS
+	count
+};
+
+enum class GraphOperation
+{
+	isEdge,
+	addVertex,
+	eraseVertex,
+	addEdge,
+	eraseEdge,
+	DFS,
+	DFSInConnectedComponents,
+	BFS,
+	BFSInConnectedComponents,
+	inverseAdjacencyList,
+	dijkstraPath,
+	shortestPath,
+	aStarPath,
+	printMatrix,
+	clear,
+	count
+};
+
+inline const char*
+graphCounterName(const GraphCounter& counter)
+{
+	static const char* names[] = {
+		"locateVertexCalls", "locateVertexScan", "findEdgeCalls", "findEdgeChain", "edgeAllocations",
+		"dfsVertices", "dfsEdges", "bfsVertices", "bfsEdges"
+	};
+	static_assert(sizeof(names) / sizeof(names[0]) == static_cast<size_t>(GraphCounter::count), "one name per GraphCounter");
+	return names[static_cast<int>(counter)];
+}
+
+inline const char*
+graphOperationName(const GraphOperation& operation)
+{
+	static const char* names[] = {
+		"isEdge", "addVertex", "eraseVertex", "addEdge", "eraseEdge", "DFS", "DFSInConnectedComponents",
+		"BFS", "BFSInConnectedComponents", "inverseAdjacencyList", "dijkstraPath", "shortestPath", "aStarPath",
+		"printMatrix", "clear"
+	};
+	static_assert(sizeof(names) / sizeof(names[0]) == static_cast<size_t>(GraphOperation::count), "one name per GraphOperation");
+	return names[static_cast<int>(operation)];
+}
+
+/*
+**	Latency of one operation; bucket i counts calls that took
+**	[2^i, 2^(i+1)) nanoseconds, bucket 0 also takes 0ns;
+*/
+struct GraphOperationStats
+{
+	static const int bucketCount = 40;
+	uint64_t calls = 0;
+	uint64_t totalNanoseconds = 0;
+	uint64_t maxNanoseconds = 0;
+	uint64_t buckets[bucketCount] = {};
+};
+
+struct GraphStatsSnapshot
+{
+	uint64_t counters[static_cast<int>(GraphCounter::count)] = {};
+	GraphOperationStats operations[static_cast<int>(GraphOperation::count)];
+
+	uint64_t get(const GraphCounter& counter) const
+	{
+		return counters[static_cast<int>(counter)];
+	}
+	const GraphOperationStats& get(const GraphOperation& operation) const
+	{
+		return operations[static_cast<int>(operation)];
+	}
+	std::string toJSON() const;
+};
+
+inline std::string
+GraphStatsSnapshot::toJSON() const
+{
+	std::ostringstream out;
+	out << "{\"counters\":{";
+	for(int i = 0; i < static_cast<int>(GraphCounter::count); ++i)
+	{
+		out << (i ? "," : "") << '"' << graphCounterName(static_cast<GraphCounter>(i)) << "\":" << counters[i];
+	}
+	out << "},\"operations\":{";
+	for(int i = 0; i < static_cast<int>(GraphOperation::count); ++i)
+	{
+		const GraphOperationStats& stats = operations[i];
+		out << (i ? "," : "") << '"' << graphOperationName(static_cast<GraphOperation>(i)) << "\":{"
+			<< "\"calls\":" << stats.calls
+			<< ",\"totalNs\":" << stats.totalNanoseconds
+			<< ",\"maxNs\":" << stats.maxNanoseconds
+			<< ",\"log2NsHistogram\":[";
+		for(int j = 0; j < GraphOperationStats::bucketCount; ++j)
+			out << (j ? "," : "") << stats.buckets[j];
+		out << "]}";
+	}
+	out << "}}";
+	return out.str();
+}
+
+/*
+**	One block per thread. Only the owning thread writes, so updates are a
+**	relaxed load and store rather than a locked read-modify-write; the
+**	atomics only make the concurrent reads in snapshot() well defined;
+*/
+class GraphThreadStats
+{
+public:
+	void add(const GraphCounter& counter, const uint64_t& amount)
+	{
+		bump(counters[static_cast<int>(counter)], amount);
+	}
+	void record(const GraphOperation& operation, const uint64_t& nanoseconds)
+	{
+		Operation& stats = operations[static_cast<int>(operation)];
+		bump(stats.calls, 1);
+		bump(stats.totalNanoseconds, nanoseconds);
+		if(nanoseconds > stats.maxNanoseconds.load(std::memory_order_relaxed))
+			stats.maxNanoseconds.store(nanoseconds, std::memory_order_relaxed);
+		int bucket = 0;
+		for(uint64_t i = nanoseconds; i > 1 && bucket < GraphOperationStats::bucketCount - 1; i >>= 1)
+			++bucket;
+		bump(stats.buckets[bucket], 1);
+	}
+	void clear()
+	{
+		for(auto &i : counters)
+			i.store(0, std::memory_order_relaxed);
+		for(auto &i : operations)
+		{
+			i.calls.store(0, std::memory_order_relaxed);
+			i.totalNanoseconds.store(0, std::memory_order_relaxed);
+			i.maxNanoseconds.store(0, std::memory_order_relaxed);
+			for(auto &j : i.buckets)
+				j.store(0, std::memory_order_relaxed);
+		}
+	}
+	void addTo(GraphStatsSnapshot& snapshot) const
+	{
+		for(int i = 0; i < static_cast<int>(GraphCounter::count); ++i)
+			snapshot.counters[i] += counters[i].load(std::memory_order_relaxed);
+		for(int i = 0; i < static_cast<int>(GraphOperation::count); ++i)
+		{
+			const Operation& from = operations[i];
+			GraphOperationStats& to = snapshot.operations[i];
+			to.calls += from.calls.load(std::memory_order_relaxed);
+			to.totalNanoseconds += from.totalNanoseconds.load(std::memory_order_relaxed);
+			uint64_t maxNanoseconds = from.maxNanoseconds.load(std::memory_order_relaxed);
+			if(maxNanoseconds > to.maxNanoseconds)
+				to.maxNanoseconds = maxNanoseconds;
+			for(int j = 0; j < GraphOperationStats::bucketCount; ++j)
+				to.buckets[j] += from.buckets[j].load(std::memory_order_relaxed);
+		}
+	}
+
+private:
+	struct Operation
+	{
+		std::atomic<uint64_t> calls{0};
+		std::atomic<uint64_t> totalNanoseconds{0};
+		std::atomic<uint64_t> maxNanoseconds{0};
+		std::atomic<uint64_t> buckets[GraphOperationStats::bucketCount] = {};
+	};
+	static void bump(std::atomic<uint64_t>& value, const uint64_t& amount)
+	{
+		value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+	}
+
+private:
+	std::atomic<uint64_t> counters[static_cast<int>(GraphCounter::count)] = {};
+	Operation operations[static_cast<int>(GraphOperation::count)];
+};
+
+class GraphInstrumentation
+{
+public:
+	static GraphThreadStats& local();
+	static GraphStatsSnapshot snapshot();
+	static void reset();
+
+private:
+	struct Registry
+	{
+		std::mutex lock;
+		std::vector<std::shared_ptr<GraphThreadStats>> threads;
+		GraphStatsSnapshot retired; // totals of threads that have exited
+	};
+	// registers the calling thread's block and folds it into retired on thread exit
+	struct ThreadHandle
+	{
+		std::shared_ptr<GraphThreadStats> stats;
+		ThreadHandle();
+		~ThreadHandle();
+	};
+	static Registry& registry();
+};
+
+inline GraphInstrumentation::Registry&
+GraphInstrumentation::registry()
+{
+	static Registry* instance = new Registry(); // never destroyed, threads may exit after main
+	return *instance;
+}
+
+inline
+GraphInstrumentation::ThreadHandle::ThreadHandle()
+:	stats(std::make_shared<GraphThreadStats>())
+{
+	Registry& r = registry();
+	std::lock_guard<std::mutex> guard(r.lock);
+	r.threads.push_back(stats);
+}
+
+inline
+GraphInstrumentation::ThreadHandle::~ThreadHandle()
+{
+	Registry& r = registry();
+	std::lock_guard<std::mutex> guard(r.lock);
+	stats->addTo(r.retired);
+	for(size_t i = 0; i < r.threads.size(); ++i)
+	{
+		if(r.threads[i] == stats)
+		{
+			r.threads[i] = r.threads.back();
+			r.threads.pop_back();
+			break;
+		}
+	}
+}
+
+inline GraphThreadStats&
+GraphInstrumentation::local()
+{
+	static thread_local ThreadHandle handle;
+	return *handle.stats;
+}
+
+inline GraphStatsSnapshot
+GraphInstrumentation::snapshot()
+{
+	Registry& r = registry();
+	std::lock_guard<std::mutex> guard(r.lock);
+	GraphStatsSnapshot result = r.retired;
+	for(const auto &i : r.threads)
+		i->addTo(result);
+	return result;
+}
+
+/*
+**	Meant for quiescent points (e.g. between test cases or after export);
+**	counters bumped concurrently with a reset may survive it;
+*/
+inline void
+GraphInstrumentation::reset()
+{
+	Registry& r = registry();
+	std::lock_guard<std::mutex> guard(r.lock);
+	r.retired = GraphStatsSnapshot();
+	for(auto &i : r.threads)
+		i->clear();
+}
+
+class GraphTimeScope
+{
+public:
+	GraphTimeScope(const GraphOperation& operation)
+	:	operation(operation)
+	,	start(std::chrono::steady_clock::now())
+	{}
+	~GraphTimeScope()
+	{
+		std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+		GraphInstrumentation::local().record(operation, elapsed.count());
+	}
+private:
+	GraphOperation operation;
+	std::chrono::steady_clock::time_point start;
+};
+
+#ifdef GRAPH_INSTRUMENTATION
+#define GRAPH_COUNT(counter, amount) GraphInstrumentation::local().add(GraphCounter::counter, (amount))
+#define GRAPH_TIME_SCOPE(operation) GraphTimeScope graphTimeScope(GraphOperation::operation)
+#else
+#define GRAPH_COUNT(counter, amount) ((void)0)
+#define GRAPH_TIME_SCOPE(operation) ((void)0)
+#endif
+
+#endif
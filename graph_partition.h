@@ -0,0 +1,178 @@
+/***********************************************************************
+** Date: 		10/19/26
+** Project :	graph_partition.h
+** Programers:	Jiahao Liang
+** File:		graph_partition.h
+** Purpose:		Edge-cut partitioning of a graph into K shards with ghost tables
+** Notes:		A partition assigns every vertex index an owning shard, either
+**				by hashing or by size-capped label propagation (fewer cut
+**				edges). buildShard() then extracts what one shard process
+**				needs: the owned vertices, their out-edges, and a ghost table
+**				naming the owner of every remote endpoint.
+***********************************************************************/
+
+#pragma once
+#ifndef _GRAPH_PARTITION_H_
+#define _GRAPH_PARTITION_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+struct GraphPartition
+{
+	int shardCount;
+	std::vector<int> owner; // owner[vertexIndex] is the shard that owns the vertex
+};
+
+/*
+**	Local edge targets are stored as their local index (>= 0), remote ones
+**	as -(ghostSlot + 1); ghostGlobal/ghostOwner describe each ghost slot;
+*/
+template<class W>
+struct GraphShard
+{
+	int shardId;
+	int shardCount;
+	std::vector<int> localToGlobal;
+	std::unordered_map<int, int> globalToLocal;
+	std::vector<size_t> offset;		// out-edges of local vertex i are [offset[i], offset[i+1])
+	std::vector<int> target;
+	std::vector<W> weight;
+	std::vector<int> ghostGlobal;
+	std::vector<int> ghostOwner;
+};
+
+inline int
+hashShard(const int& vertexIndex, const int& shardCount)
+{
+	uint32_t hash = static_cast<uint32_t>(vertexIndex) * 2654435761u;
+	return static_cast<int>((static_cast<uint64_t>(hash) * shardCount) >> 32);
+}
+
+template<class Graph>
+GraphPartition
+hashPartition(const Graph& graph, const int& shardCount)
+{
+	GraphPartition partition;
+	partition.shardCount = shardCount;
+	partition.owner.resize(graph.getVertexCount());
+	for(size_t i = 0; i < partition.owner.size(); ++i)
+		partition.owner[i] = hashShard(i, shardCount);
+	return partition;
+}
+
+/*
+**	Starts from contiguous blocks of indices, then repeatedly moves each
+**	vertex to the shard most of its neighbours are in, as long as that
+**	shard stays under imbalance * (vertexCount / shardCount) vertices;
+*/
+template<class Graph>
+GraphPartition
+labelPropagationPartition(const Graph& graph, const int& shardCount, const int& iterations = 10, const double& imbalance = 1.1)
+{
+	typedef typename Graph::WeightType W;
+	GraphPartition partition;
+	partition.shardCount = shardCount;
+	size_t vertexCount = graph.getVertexCount();
+	partition.owner.resize(vertexCount);
+	std::vector<size_t> shardSize(shardCount, 0);
+	for(size_t i = 0; i < vertexCount; ++i)
+	{
+		partition.owner[i] = static_cast<int>(i * shardCount / vertexCount);
+		++shardSize[partition.owner[i]];
+	}
+	size_t capacity = static_cast<size_t>(imbalance * vertexCount / shardCount) + 1;
+
+	std::vector<int> votes(shardCount, 0);
+	for(int round = 0; round < iterations; ++round)
+	{
+		size_t moved = 0;
+		for(size_t i = 0; i < vertexCount; ++i)
+		{
+			std::fill(votes.begin(), votes.end(), 0);
+			graph.forEachAdjacent(i, [&](const int& j, const W&)
+			{
+				++votes[partition.owner[j]];
+			});
+			int current = partition.owner[i];
+			int best = current;
+			for(int shard = 0; shard < shardCount; ++shard)
+			{
+				if(votes[shard] > votes[best] && shardSize[shard] < capacity)
+					best = shard;
+			}
+			if(best != current)
+			{
+				--shardSize[current];
+				++shardSize[best];
+				partition.owner[i] = best;
+				++moved;
+			}
+		}
+		if(moved == 0)
+			break;
+	}
+	return partition;
+}
+
+template<class Graph>
+size_t
+countCutEdges(const Graph& graph, const GraphPartition& partition)
+{
+	typedef typename Graph::WeightType W;
+	size_t cut = 0;
+	for(int i = 0; i < graph.getVertexCount(); ++i)
+	{
+		graph.forEachAdjacent(i, [&](const int& j, const W&)
+		{
+			if(partition.owner[i] != partition.owner[j])
+				++cut;
+		});
+	}
+	return cut;
+}
+
+template<class Graph>
+GraphShard<typename Graph::WeightType>
+buildShard(const Graph& graph, const GraphPartition& partition, const int& shardId)
+{
+	typedef typename Graph::WeightType W;
+	GraphShard<W> shard;
+	shard.shardId = shardId;
+	shard.shardCount = partition.shardCount;
+	for(int i = 0; i < graph.getVertexCount(); ++i)
+	{
+		if(partition.owner[i] != shardId) continue;
+		shard.globalToLocal[i] = shard.localToGlobal.size();
+		shard.localToGlobal.push_back(i);
+	}
+
+	std::unordered_map<int, int> ghostSlot;
+	shard.offset.push_back(0);
+	for(size_t i = 0; i < shard.localToGlobal.size(); ++i)
+	{
+		graph.forEachAdjacent(shard.localToGlobal[i], [&](const int& j, const W& weight)
+		{
+			if(partition.owner[j] == shardId)
+				shard.target.push_back(shard.globalToLocal[j]);
+			else
+			{
+				auto found = ghostSlot.find(j);
+				if(found == ghostSlot.end())
+				{
+					found = ghostSlot.insert(std::make_pair(j, static_cast<int>(shard.ghostGlobal.size()))).first;
+					shard.ghostGlobal.push_back(j);
+					shard.ghostOwner.push_back(partition.owner[j]);
+				}
+				shard.target.push_back(-(found->second + 1));
+			}
+			shard.weight.push_back(weight);
+		});
+		shard.offset.push_back(shard.target.size());
+	}
+	return shard;
+}
+
+#endif
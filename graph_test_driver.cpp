@@ -0,0 +1,829 @@
+/***********************************************************************
+** Date: 		10/19/26
+** Project :	graph_test_driver.cpp
+** Programers:	Jiahao Liang
+** File:		graph_test_driver.cpp
+** Purpose:		Regression checks for the graph containers and algorithms
+** Notes:		Build with g++ -std=c++17 -pthread graph_test_driver.cpp; every
+**				failed check is printed and the exit status is the number of
+**				failures. Add -DGRAPH_INSTRUMENTATION to check the hooks too.
+***********************************************************************/
+
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <iostream>
+#include <iterator>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "adjacency_list.h"
+#include "adjacency_matrix.h"
+#include "compressed_adjacency_list.h"
+#include "graph.h"
+#include "identity_vertex_map.h"
+#include "minimum_spanning_forest.h"
+#include "multi_source_bfs.h"
+#include "path_search.h"
+#include "sharded_traversal.h"
+#include "topological_sort.h"
+#include "triangle_counting.h"
+
+int failures = 0;
+
+void check(const bool& condition, const char* description)
+{
+	if(condition) return;
+	std::cout << "FAILED: " << description << std::endl;
+	++failures;
+}
+
+void testGraphZeroWeight()
+{
+	// 4 vertices, 6 possible undirected edges: 3 edges reach the 0.25 threshold
+	Graph<int, false, int> sparse({0, 1, 2, 3}, 0.6, 0.1);
+	sparse.addEdge(0, 3, 0);
+	check(!sparse.isDense(), "zero weight: graph starts sparse");
+	check(sparse.getEdgeCount() == 0, "zero weight: sparse layout ignores W() weight");
+	check(!sparse.isEdge(0, 3), "zero weight: sparse layout stores no W() edge");
+
+	Graph<int, false, int> dense({0, 1, 2, 3});
+	dense.addEdge(0, 1, 1);
+	dense.addEdge(1, 2, 1);
+	dense.addEdge(2, 3, 1);
+	check(dense.isDense(), "zero weight: graph switches to dense");
+	dense.addEdge(0, 3, 0);
+	check(dense.getEdgeCount() == 3, "zero weight: dense layout ignores W() weight");
+	check(!dense.isEdge(0, 3), "zero weight: dense layout stores no W() edge");
+}
+
+template<class Graph>
+typename Graph::WeightType
+edgeWeight(const Graph& graph, const int& srcVertex, const int& dstVertex)
+{
+	typedef typename Graph::WeightType W;
+	W found = W();
+	int dstIndex = graph.getVertexIndex(dstVertex);
+	graph.forEachAdjacent(graph.getVertexIndex(srcVertex), [&](const int& j, const W& weight)
+	{
+		if(j == dstIndex)
+			found = weight;
+	});
+	return found;
+}
+
+void testListErase()
+{
+	AdjacencyList<int, false, int> undirected({0, 1, 2, 3, 4});
+	undirected.addEdge(0, 1);
+	undirected.addEdge(1, 2);
+	undirected.addEdge(2, 2);
+	undirected.addEdge(0, 3);
+	undirected.addEdge(3, 4);
+	check(undirected.getEdgeCount() == 5, "list erase: undirected edge count");
+	undirected.eraseEdge(0, 4);
+	check(undirected.getEdgeCount() == 5, "list erase: erasing a missing edge keeps the count");
+	undirected.eraseVertex(2);
+	check(undirected.getVertexCount() == 4, "list erase: undirected vertex count after eraseVertex");
+	check(undirected.getEdgeCount() == 3, "list erase: eraseVertex drops incident edges and the self-loop once");
+	check(undirected.getVertexIndex(4) == 2, "list erase: last vertex moves into the freed slot");
+	check(undirected.isEdge(3, 4) && undirected.isEdge(4, 3), "list erase: edges of the moved vertex are renumbered");
+	check(undirected.isEdge(0, 1) && !undirected.isEdge(1, 4), "list erase: unrelated edges survive");
+	undirected.eraseEdge(4, 3);
+	check(undirected.getEdgeCount() == 2 && !undirected.isEdge(3, 4), "list erase: undirected eraseEdge removes both directions");
+
+	AdjacencyList<int, true, int> directed({0, 1, 2, 3});
+	directed.addEdge(0, 1);
+	directed.addEdge(1, 0);
+	directed.addEdge(1, 1);
+	directed.addEdge(2, 1);
+	directed.addEdge(1, 3);
+	directed.addEdge(2, 3);
+	check(directed.getEdgeCount() == 6, "list erase: directed edge count");
+	directed.eraseVertex(1);
+	check(directed.getEdgeCount() == 1, "list erase: directed eraseVertex drops in-edges, out-edges and the self-loop");
+	check(directed.isEdge(2, 3) && !directed.isEdge(3, 2), "list erase: directed edge survives renumbering");
+
+	AdjacencyList<int, false, int> selfLoop({0, 1});
+	selfLoop.addEdge(0, 0);
+	selfLoop.addEdge(0, 1);
+	selfLoop.eraseEdge(0, 0);
+	check(selfLoop.getEdgeCount() == 1 && !selfLoop.isEdge(0, 0), "list erase: undirected self-loop erased once");
+}
+
+void testListParallelEdges()
+{
+	AdjacencyList<int, false, int> list({0, 1});
+	list.addEdge(0, 1, 2);
+	list.addEdge(0, 1, 3);
+	check(list.getEdgeCount() == 2, "list parallel: parallel edges are counted separately");
+	list.eraseEdge(0, 1);
+	check(list.getEdgeCount() == 1 && list.isEdge(0, 1) && list.isEdge(1, 0), "list parallel: eraseEdge removes one copy");
+	list.eraseVertex(1);
+	check(list.getEdgeCount() == 0, "list parallel: eraseVertex drops the remaining copy");
+}
+
+void testMatrixVertices()
+{
+	AdjacencyMatrix<int, true, int> matrix(std::vector<int>{0, 1, 2});
+	matrix.addEdge(0, 1);
+	matrix.addEdge(1, 1);
+	matrix.addEdge(1, 2);
+	matrix.addVertex(3);
+	check(matrix.getVertexCount() == 4, "matrix vertices: addVertex grows the matrix");
+	matrix.addEdge(3, 1);
+	matrix.addEdge(2, 3);
+	check(matrix.getEdgeCount() == 5, "matrix vertices: edge count after addVertex");
+	matrix.addEdge(2, 3, 4);
+	check(matrix.getEdgeCount() == 5, "matrix vertices: overwriting an edge does not count it again");
+	matrix.eraseEdge(3, 2);
+	check(matrix.getEdgeCount() == 5, "matrix vertices: erasing a missing edge keeps the count");
+	matrix.eraseVertex(1);
+	check(matrix.getVertexCount() == 3, "matrix vertices: eraseVertex shrinks the matrix");
+	check(matrix.getEdgeCount() == 1, "matrix vertices: eraseVertex drops in-edges, out-edges and the self-loop");
+	check(matrix.isEdge(2, 3) && edgeWeight(matrix, 2, 3) == 4, "matrix vertices: remaining edge keeps its weight");
+}
+
+void testGraphDensitySwitch()
+{
+	// 5 vertices, 10 possible undirected edges: dense at >= 0.25, sparse again at <= 0.125
+	Graph<int, false, int> graph({0, 1, 2, 3, 4});
+	graph.addEdge(0, 0, 7);
+	graph.addEdge(0, 1, 2);
+	check(!graph.isDense(), "density: a self-loop and one edge stay sparse");
+	graph.addEdge(1, 2, 3);
+	check(graph.isDense(), "density: switches to dense at the threshold");
+	check(graph.getEdgeCount() == 3, "density: edge count survives the switch to dense");
+	check(graph.isEdge(0, 0) && edgeWeight(graph, 0, 0) == 7, "density: self-loop survives the switch to dense");
+	check(graph.isEdge(2, 1) && edgeWeight(graph, 2, 1) == 3, "density: undirected edge survives the switch to dense");
+	graph.eraseEdge(1, 2);
+	check(graph.isDense(), "density: stays dense between the thresholds");
+	graph.eraseEdge(0, 1);
+	check(!graph.isDense(), "density: switches back to sparse");
+	check(graph.getEdgeCount() == 1 && graph.isEdge(0, 0), "density: self-loop survives the switch to sparse");
+	graph.eraseVertex(0);
+	check(graph.getEdgeCount() == 0 && graph.getVertexCount() == 4, "density: eraseVertex drops the self-loop");
+}
+
+void testGraphParallelEdges()
+{
+	Graph<int, true, int> sparse({0, 1, 2, 3}, 0.9, 0.1);
+	sparse.addEdge(0, 1, 2);
+	sparse.addEdge(0, 1, 5);
+	check(!sparse.isDense(), "graph parallel: graph stays sparse");
+	check(sparse.getEdgeCount() == 1 && edgeWeight(sparse, 0, 1) == 5, "graph parallel: sparse layout overwrites the weight");
+
+	Graph<int, true, int> dense({0, 1}, 0.25, 0.1);
+	dense.addEdge(0, 1, 2);
+	check(dense.isDense(), "graph parallel: graph switches to dense");
+	dense.addEdge(0, 1, 5);
+	check(dense.getEdgeCount() == 1 && edgeWeight(dense, 0, 1) == 5, "graph parallel: dense layout overwrites the weight");
+}
+
+void testGraphAssignment()
+{
+	Graph<int, false, int> source({0, 1, 2}), target({5});
+	source.addEdge(0, 1, 4);
+	target = source;
+	source.eraseEdge(0, 1);
+	check(target.getVertexCount() == 3 && target.isEdge(0, 1) && edgeWeight(target, 0, 1) == 4, "graph assignment: the copy owns its own edges");
+	check(!source.isEdge(0, 1), "graph assignment: the source is unaffected by the copy");
+
+	Graph<int, false, int> dense({0, 1}, 0.25, 0.1);
+	dense.addEdge(0, 1, 3);
+	target = dense;
+	check(target.isDense() && edgeWeight(target, 1, 0) == 3, "graph assignment: a dense graph copies as dense");
+	target = target;
+	check(target.isDense() && target.getEdgeCount() == 1, "graph assignment: self-assignment keeps the graph");
+}
+
+void testInverseAdjacencyList()
+{
+	AdjacencyList<int, true, int> list({0, 1, 2});
+	list.addEdge(0, 1, 4);
+	list.addEdge(0, 2, 5);
+	list.addEdge(2, 1, 6);
+	AdjacencyList<int, true, int>* inverse = list.inverseAdjacencyList();
+	int nodes = 0;
+	for(int i = 0; i < inverse->getVertexCount(); ++i)
+		inverse->forEachAdjacent(i, [&](const int&, const int&) { ++nodes; });
+	check(inverse->getEdgeCount() == 3 && nodes == 3, "inverse: one reversed edge per edge");
+	check(edgeWeight(*inverse, 1, 0) == 4 && edgeWeight(*inverse, 1, 2) == 6 && !inverse->isEdge(0, 1), "inverse: edges are reversed with their weights");
+	delete inverse;
+
+	AdjacencyList<IdentityVertexMap<int>, true, int> identity(3);
+	identity.addEdge(0, 1, 4);
+	identity.addEdge(2, 1, 6);
+	AdjacencyList<IdentityVertexMap<int>, true, int>* identityInverse = identity.inverseAdjacencyList();
+	check(identityInverse->getEdgeCount() == 2 && edgeWeight(*identityInverse, 1, 2) == 6 && !identityInverse->isEdge(0, 1), "inverse: identity edges are reversed with their weights");
+	delete identityInverse;
+}
+
+void testMultiSourceOrdinal()
+{
+	AdjacencyList<IdentityVertexMap<int>, true, int> ring(3);
+	ring.addEdge(0, 1);
+	ring.addEdge(1, 2);
+	ring.addEdge(2, 0);
+	MultiSourceBFS<AdjacencyList<IdentityVertexMap<int>, true, int>> bfs(ring);
+	bfs.run(std::vector<int>{0});
+	check(bfs.isReachable(0, 2), "multi-source: source 0 reaches vertex 2");
+	check(!bfs.isReachable(1, 2), "multi-source: an unused ordinal reaches nothing");
+	check(!bfs.isReachable(-1, 2), "multi-source: a negative ordinal reaches nothing");
+	check(!bfs.isReachable(64, 2) && !bfs.isReachable(1000, 2), "multi-source: an ordinal past the mask reaches nothing");
+}
+
+// plain single-source BFS, the reference for the multi-source and sharded searches
+template<class Graph>
+std::vector<char>
+reachableFrom(const Graph& graph, const int& srcIndex)
+{
+	std::vector<char> reached(graph.getVertexCount(), false);
+	std::queue<int> q;
+	q.push(srcIndex);
+	reached[srcIndex] = true;
+	while(!q.empty())
+	{
+		int front = q.front();
+		q.pop();
+		graph.forEachAdjacent(front, [&](const int& j, const typename Graph::WeightType&)
+		{
+			if(reached[j]) return;
+			reached[j] = true;
+			q.push(j);
+		});
+	}
+	return reached;
+}
+
+void testMultiSourceReachability()
+{
+	typedef AdjacencyList<IdentityVertexMap<int>, true, int> Identity;
+	std::mt19937 random(29);
+	const int vertexCount = 400;
+	// sparse enough that many sources only reach part of the graph
+	Identity graph(vertexCount);
+	for(int i = 0; i < vertexCount; ++i)
+		graph.addEdge(random() % vertexCount, random() % vertexCount);
+	std::vector<int> sources;
+	for(int i = 0; i < 300; ++i)
+		sources.push_back(random() % vertexCount);
+	std::vector<std::vector<char>> expected;
+	for(int source : sources)
+		expected.push_back(reachableFrom(graph, source));
+
+	MultiSourceBFS<Identity> bfs(graph);
+	bfs.run(std::vector<int>(sources.begin(), sources.begin() + 64));
+	bool same = true;
+	for(int i = 0; i < 64; ++i)
+	{
+		for(int j = 0; j < vertexCount; ++j)
+			same = same && bfs.isReachable(i, j) == static_cast<bool>(expected[i][j]);
+	}
+	check(same, "multi-source: uint64_t masks match per-source BFS");
+
+	MultiSourceBFS<Identity, std::bitset<256>> wide(graph);
+	wide.run(std::vector<int>(sources.begin(), sources.begin() + 256));
+	same = true;
+	for(int i = 0; i < 256; ++i)
+	{
+		for(int j = 0; j < vertexCount; ++j)
+			same = same && wide.isReachable(i, j) == static_cast<bool>(expected[i][j]);
+	}
+	check(same, "multi-source: std::bitset<256> masks match per-source BFS");
+	check(!wide.isReachable(256, sources[0]), "multi-source: an ordinal past the bitset reaches nothing");
+
+	// 300 sources: 5 batches of 64 (the last one partial) and 2 of 256
+	std::vector<int> visitedSources(sources.size(), 0);
+	same = true;
+	batchedMultiSourceBFS(graph, sources, [&](const int& first, const MultiSourceBFS<Identity>& batch)
+	{
+		for(int i = 0; i < 64 && first + i < static_cast<int>(sources.size()); ++i)
+		{
+			++visitedSources[first + i];
+			for(int j = 0; j < vertexCount; ++j)
+				same = same && batch.isReachable(i, j) == static_cast<bool>(expected[first + i][j]);
+		}
+	});
+	check(same && visitedSources == std::vector<int>(sources.size(), 1), "multi-source: uint64_t batches cover every source once and match");
+	same = true;
+	int batches = 0;
+	batchedMultiSourceBFS<std::bitset<256>>(graph, sources, [&](const int& first, const MultiSourceBFS<Identity, std::bitset<256>>& batch)
+	{
+		++batches;
+		for(int j = 0; j < vertexCount; ++j)
+		{
+			for(int i = 0; i < 256 && first + i < static_cast<int>(sources.size()); ++i)
+				same = same && batch.getReached(j).test(i) == static_cast<bool>(expected[first + i][j]);
+		}
+	});
+	check(same && batches == 2, "multi-source: std::bitset<256> batches match");
+}
+
+void testShortestPath()
+{
+	// 0 -> 1 -> 3 costs 2, 0 -> 2 -> 3 costs 4, 0 -> 3 costs 5
+	AdjacencyList<int, true, int> graph({0, 1, 2, 3});
+	graph.addEdge(0, 1, 1);
+	graph.addEdge(1, 3, 1);
+	graph.addEdge(0, 2, 2);
+	graph.addEdge(2, 3, 2);
+	graph.addEdge(0, 3, 5);
+	check(graph.shortestPath(0, 3) == std::vector<int>({0, 1, 3}), "path: bidirectional Dijkstra finds the cheapest path");
+	check(graph.aStarPath(0, 3, [](const int&, const int&) { return 0; }) == std::vector<int>({0, 1, 3}), "path: A* finds the cheapest path");
+	graph.eraseEdge(1, 3);
+	check(graph.shortestPath(0, 3) == std::vector<int>({0, 2, 3}), "path: mutation invalidates the member scratch");
+	check(graph.shortestPath(3, 0).empty(), "path: unreachable target gives an empty path");
+
+	// concurrent readers of one const graph each bring their own scratch
+	const AdjacencyList<int, true, int>& reader = graph;
+	std::vector<int> agreed(4, 0);
+	std::vector<std::thread> threads;
+	for(int i = 0; i < 4; ++i)
+	{
+		threads.emplace_back([&, i]()
+		{
+			PathSearchScratch<int> scratch;
+			bool same = true;
+			for(int j = 0; j < 1000; ++j)
+				same = same && bidirectionalDijkstraPath(reader, scratch, 0, 3) == std::vector<int>({0, 2, 3});
+			agreed[i] = same;
+		});
+	}
+	for(auto &i : threads)
+		i.join();
+	check(agreed == std::vector<int>(4, 1), "path: concurrent queries with per-thread scratch agree");
+}
+
+// sequential Kruskal over the same edges, the reference for minimumSpanningForest
+template<class Graph>
+typename Graph::WeightType
+kruskalWeight(const Graph& graph, int& forestEdges)
+{
+	typedef typename Graph::WeightType W;
+	std::vector<std::pair<W, std::pair<int, int>>> edges;
+	for(int i = 0; i < graph.getVertexCount(); ++i)
+	{
+		graph.forEachAdjacent(i, [&](const int& j, const W& weight)
+		{
+			if(i < j)
+				edges.push_back(std::make_pair(weight, std::make_pair(i, j)));
+		});
+	}
+	std::sort(edges.begin(), edges.end());
+	std::vector<int> parent(graph.getVertexCount());
+	for(size_t i = 0; i < parent.size(); ++i)
+		parent[i] = i;
+	auto find = [&](int i)
+	{
+		while(parent[i] != i)
+			i = parent[i] = parent[parent[i]];
+		return i;
+	};
+	W total = W();
+	forestEdges = 0;
+	for(const auto &i : edges)
+	{
+		int first = find(i.second.first), second = find(i.second.second);
+		if(first == second) continue;
+		parent[first] = second;
+		total += i.first;
+		++forestEdges;
+	}
+	return total;
+}
+
+void testMinimumSpanningForest()
+{
+	std::mt19937 random(31);
+	for(int round = 0; round < 20; ++round)
+	{
+		// few distinct weights so ties are common; sparse enough to leave several components
+		int vertexCount = 50 + round * 20;
+		AdjacencyList<IdentityVertexMap<int>, false, int> graph(vertexCount);
+		for(int i = 0; i < vertexCount; ++i)
+			graph.addEdge(random() % vertexCount, random() % vertexCount, 1 + random() % 5);
+		int expectedEdges = 0;
+		int expectedWeight = kruskalWeight(graph, expectedEdges);
+		for(unsigned threadCount = 1; threadCount <= 4; ++threadCount)
+		{
+			SpanningForest<int, int> forest = minimumSpanningForest(graph, threadCount);
+			check(forest.totalWeight == expectedWeight, "spanning forest: total weight matches Kruskal");
+			check(static_cast<int>(forest.edges.size()) == expectedEdges, "spanning forest: edge count matches Kruskal");
+		}
+	}
+
+	AdjacencyList<int, false, double> list({0, 1, 2, 3});
+	list.addEdge(0, 1, 1.5);
+	list.addEdge(1, 2, 0.5);
+	list.addEdge(0, 2, 1.0);
+	SpanningForest<int, double> forest = minimumSpanningForest(list, 2);
+	check(forest.totalWeight == 1.5 && forest.edges.size() == 2, "spanning forest: isolated vertex and cycle on a generic list");
+}
+
+// O(V^3) count over an undirected, loop-free view of the graph, the reference for countTriangles
+template<class Graph>
+uint64_t
+bruteForceTriangles(const Graph& graph, std::vector<uint64_t>& triangles, std::vector<int>& degree)
+{
+	typedef typename Graph::WeightType W;
+	int vertexCount = graph.getVertexCount();
+	std::vector<std::vector<char>> adjacent(vertexCount, std::vector<char>(vertexCount, 0));
+	for(int i = 0; i < vertexCount; ++i)
+	{
+		graph.forEachAdjacent(i, [&](const int& j, const W&)
+		{
+			if(i != j)
+				adjacent[i][j] = adjacent[j][i] = 1;
+		});
+	}
+	triangles.assign(vertexCount, 0);
+	degree.assign(vertexCount, 0);
+	uint64_t total = 0;
+	for(int i = 0; i < vertexCount; ++i)
+	{
+		for(int j = 0; j < vertexCount; ++j)
+			degree[i] += adjacent[i][j];
+		for(int j = i + 1; j < vertexCount; ++j)
+		{
+			if(!adjacent[i][j]) continue;
+			for(int k = j + 1; k < vertexCount; ++k)
+			{
+				if(!adjacent[i][k] || !adjacent[j][k]) continue;
+				++triangles[i];
+				++triangles[j];
+				++triangles[k];
+				++total;
+			}
+		}
+	}
+	return total;
+}
+
+template<class Graph>
+bool
+matchesBruteForce(const Graph& graph, const unsigned& threadCount)
+{
+	std::vector<uint64_t> triangles;
+	std::vector<int> degree;
+	uint64_t total = bruteForceTriangles(graph, triangles, degree);
+	TriangleCounts counts = countTriangles(graph, threadCount);
+	if(counts.totalTriangles != total || counts.triangles != triangles || counts.degree != degree)
+		return false;
+	for(size_t i = 0; i < degree.size(); ++i)
+	{
+		double expected = degree[i] < 2 ? 0 : 2.0 * triangles[i] / (static_cast<double>(degree[i]) * (degree[i] - 1));
+		if(std::fabs(counts.clustering[i] - expected) > 1e-12)
+			return false;
+	}
+	return true;
+}
+
+void testTriangleCounting()
+{
+	// the kernels against std::set_intersection, similar lengths (block merge) and lopsided ones (galloping)
+	std::mt19937 random(32);
+	bool mergeAgrees = true, gallopAgrees = true, dispatchAgrees = true;
+	for(int round = 0; round < 200; ++round)
+	{
+		int firstSize = random() % 40;
+		int secondSize = round % 2 == 0 ? random() % 40 : 33 * (firstSize + 1) + random() % 200;
+		int range = 1 + (firstSize + secondSize) * (1 + round % 3);
+		std::vector<int> first, second, expected, found;
+		for(int i = 0; i < firstSize; ++i)
+			first.push_back(random() % range);
+		for(int i = 0; i < secondSize; ++i)
+			second.push_back(random() % range);
+		for(auto list : {&first, &second})
+		{
+			std::sort(list->begin(), list->end());
+			list->erase(std::unique(list->begin(), list->end()), list->end());
+		}
+		std::set_intersection(first.begin(), first.end(), second.begin(), second.end(), std::back_inserter(expected));
+		auto collect = [&](const int& x) { found.push_back(x); };
+		const int* firstBegin = first.data();
+		const int* secondBegin = second.data();
+		intersectSortedMerge(firstBegin, firstBegin + first.size(), secondBegin, secondBegin + second.size(), collect);
+		std::sort(found.begin(), found.end());
+		mergeAgrees = mergeAgrees && found == expected;
+		found.clear();
+		intersectSortedGalloping(firstBegin, firstBegin + first.size(), secondBegin, secondBegin + second.size(), collect);
+		gallopAgrees = gallopAgrees && found == expected;
+		found.clear();
+		intersectSorted(secondBegin, secondBegin + second.size(), firstBegin, firstBegin + first.size(), collect);
+		std::sort(found.begin(), found.end());
+		dispatchAgrees = dispatchAgrees && found == expected;
+	}
+	check(mergeAgrees, "triangles: block merge matches set_intersection");
+	check(gallopAgrees, "triangles: galloping matches set_intersection");
+	check(dispatchAgrees, "triangles: intersectSorted matches set_intersection either way round");
+
+	// triangle 0-1-2 with 3 hanging off 0, given with duplicates, reversed copies and self-loops
+	AdjacencyList<IdentityVertexMap<int>, false, int> small(4);
+	small.addEdge(0, 1);
+	small.addEdge(1, 0);
+	small.addEdge(1, 2);
+	small.addEdge(2, 0);
+	small.addEdge(0, 3);
+	small.addEdge(2, 2);
+	small.addEdge(3, 3);
+	TriangleCounts counts = countTriangles(small, 2);
+	check(counts.totalTriangles == 1 && counts.triangles == std::vector<uint64_t>({1, 1, 1, 0}), "triangles: duplicates and self-loops are not counted");
+	check(counts.degree == std::vector<int>({3, 2, 2, 1}), "triangles: degree counts distinct neighbours only");
+	check(std::fabs(counts.clustering[0] - 1.0 / 3) < 1e-12 && counts.clustering[1] == 1 && counts.clustering[3] == 0, "triangles: clustering coefficients of a small graph");
+
+	// dense random graphs keep every out-list long enough for the SSE2 blocks
+	bool undirectedAgrees = true, directedAgrees = true;
+	for(int round = 0; round < 4; ++round)
+	{
+		int vertexCount = 60 + 20 * round;
+		AdjacencyList<IdentityVertexMap<int>, false, int> undirected(vertexCount);
+		AdjacencyList<IdentityVertexMap<int>, true, int> directed(vertexCount);
+		for(int i = 0; i < 15 * vertexCount; ++i)
+		{
+			undirected.addEdge(random() % vertexCount, random() % vertexCount);
+			directed.addEdge(random() % vertexCount, random() % vertexCount);
+		}
+		for(unsigned threadCount = 1; threadCount <= 4; ++threadCount)
+		{
+			undirectedAgrees = undirectedAgrees && matchesBruteForce(undirected, threadCount);
+			directedAgrees = directedAgrees && matchesBruteForce(directed, threadCount);
+		}
+	}
+	check(undirectedAgrees, "triangles: random undirected multigraphs match the brute-force count");
+	check(directedAgrees, "triangles: random directed graphs match the brute-force count, ignoring direction");
+
+	// leaves see a short out-list {hub, 3 of the clique}, the hub sees 200 clique members above it: galloping
+	const int cliqueSize = 250, hubLinks = 200, leafCount = 10;
+	const int hub = cliqueSize;
+	AdjacencyList<IdentityVertexMap<int>, false, int> lopsided(cliqueSize + 1 + leafCount);
+	for(int i = 0; i < cliqueSize; ++i)
+	{
+		for(int j = i + 1; j < cliqueSize; ++j)
+			lopsided.addEdge(i, j);
+	}
+	for(int i = 0; i < hubLinks; ++i)
+		lopsided.addEdge(hub, i);
+	for(int i = 0; i < leafCount; ++i)
+	{
+		int leaf = hub + 1 + i;
+		lopsided.addEdge(leaf, hub);
+		for(int j = 0; j < 3; ++j)
+			lopsided.addEdge(leaf, (7 * i + 61 * j) % cliqueSize);
+	}
+	bool lopsidedAgrees = true;
+	for(unsigned threadCount = 1; threadCount <= 4; ++threadCount)
+		lopsidedAgrees = lopsidedAgrees && matchesBruteForce(lopsided, threadCount);
+	check(lopsidedAgrees, "triangles: a hub below a large clique matches the brute-force count");
+}
+
+void testCompressedIdentity()
+{
+	const int vertexCount = 20000;
+	AdjacencyList<IdentityVertexMap<int>, true, uint8_t> ring(vertexCount);
+	for(int i = 0; i < vertexCount; ++i)
+		ring.addEdge(i, (i + 1) % vertexCount, 1 + i % 3);
+	CompressedAdjacencyList<IdentityVertexMap<int>, true, uint8_t> compressed(ring);
+	check(compressed.getVertexCount() == vertexCount && compressed.getEdgeCount() == vertexCount, "compressed identity: counts match the source");
+	check(compressed.getVertex(123) == 123 && compressed.getVertexIndex(123) == 123, "compressed identity: a vertex is its own index");
+	check(compressed.getVertexIndex(-1) == -1 && compressed.getVertexIndex(vertexCount) == -1, "compressed identity: lookups outside the range fail");
+	check(compressed.isEdge(vertexCount - 1, 0) && !compressed.isEdge(0, 2), "compressed identity: edges match the source");
+	// about one byte per id and per weight plus the offsets, with no vertex table on top
+	check(compressed.getByteSize() < 2 * vertexCount + 16 + (vertexCount + 1) * sizeof(uint64_t), "compressed identity: no vertex table is stored");
+
+	MultiSourceBFS<CompressedAdjacencyList<IdentityVertexMap<int>, true, uint8_t>> bfs(compressed);
+	bfs.run(std::vector<int>{0, vertexCount / 2});
+	bool reachable = true;
+	for(int i = 0; i < vertexCount; ++i)
+		reachable = reachable && bfs.isReachable(0, i) && bfs.isReachable(1, i);
+	check(reachable, "compressed identity: multi-source BFS reaches the whole ring");
+}
+
+// largest difference between a weight and its compressed copy, over every edge of the source
+template<class StoredW, class W>
+double
+compressedWeightError(const AdjacencyList<IdentityVertexMap<int>, true, W>& graph)
+{
+	CompressedAdjacencyList<IdentityVertexMap<int>, true, W, StoredW> compressed(graph);
+	double error = 0;
+	for(int i = 0; i < graph.getVertexCount(); ++i)
+	{
+		graph.forEachAdjacent(i, [&](const int& j, const W& weight)
+		{
+			error = std::max(error, std::fabs(static_cast<double>(edgeWeight(compressed, i, j)) - static_cast<double>(weight)));
+		});
+	}
+	return error;
+}
+
+void testCompressedWeights()
+{
+	// every vertex gets a few distinct out-neighbours, so each edge has one weight
+	const int vertexCount = 200;
+	std::mt19937 random(33);
+	std::uniform_real_distribution<double> real(-3, 7.5);
+	AdjacencyList<IdentityVertexMap<int>, true, double> reals(vertexCount);
+	AdjacencyList<IdentityVertexMap<int>, true, int> integers(vertexCount);
+	AdjacencyList<IdentityVertexMap<int>, true, uint8_t> bytes(vertexCount);
+	for(int i = 0; i < vertexCount; ++i)
+	{
+		for(int j = 1; j <= 4; ++j)
+		{
+			reals.addEdge(i, (i + 7 * j) % vertexCount, real(random));
+			integers.addEdge(i, (i + 7 * j) % vertexCount, static_cast<int>(random() % 200000) - 100000);
+			bytes.addEdge(i, (i + 7 * j) % vertexCount, static_cast<uint8_t>(random()));
+		}
+	}
+	reals.addEdge(0, 1, -3);
+	reals.addEdge(0, 2, 7.5);
+	integers.addEdge(0, 1, 300);
+
+	CompressedAdjacencyList<IdentityVertexMap<int>, true, double, uint8_t> quantized(reals);
+	check(compressedWeightError<uint8_t>(reals) <= 10.5 / 255 / 2 + 1e-12, "compressed weights: quantized doubles are within half a step");
+	check(edgeWeight(quantized, 0, 1) == -3 && std::fabs(edgeWeight(quantized, 0, 2) - 7.5) < 1e-12, "compressed weights: quantization keeps the minimum and maximum");
+	check(compressedWeightError<double>(reals) == 0, "compressed weights: doubles stored as double are exact");
+	check(compressedWeightError<float>(reals) < 1e-6, "compressed weights: doubles stored as float are rounded, not quantized");
+	check(compressedWeightError<int>(integers) == 0 && compressedWeightError<int64_t>(integers) == 0, "compressed weights: ints stored as int or int64_t are exact");
+	check(compressedWeightError<uint8_t>(bytes) == 0 && compressedWeightError<int>(bytes) == 0, "compressed weights: uint8_t weights are exact");
+
+	// a constant weight gives a zero scale and decodes back to itself
+	AdjacencyList<IdentityVertexMap<int>, true, double> constant(3);
+	constant.addEdge(0, 1, 2.5);
+	constant.addEdge(1, 2, 2.5);
+	check(compressedWeightError<uint8_t>(constant) == 0, "compressed weights: a single weight value survives quantization");
+}
+
+void testShardedTraversal()
+{
+	const int vertexCount = 300;
+	std::mt19937 random(34);
+	AdjacencyList<IdentityVertexMap<int>, true, int> graph(vertexCount);
+	for(int i = 0; i < 3 * vertexCount; ++i)
+		graph.addEdge(random() % vertexCount, random() % vertexCount, 1 + random() % 9);
+	MultiSourceBFS<AdjacencyList<IdentityVertexMap<int>, true, int>> reference(graph);
+	reference.run(std::vector<int>{0});
+	GraphPartition partition = labelPropagationPartition(graph, 3);
+
+	// every shard compares its own vertices with a sequential run; a child reports through its exit status
+	bool succeeded = runLocalShards(3, [&](ShardTransport& transport)
+	{
+		GraphShard<int> shard = buildShard(graph, partition, transport.getShardId());
+		std::vector<int> level = shardedBFS(shard, transport, 0);
+		shardedSSSP(shard, transport, 0);
+		for(size_t i = 0; i < level.size(); ++i)
+		{
+			if((level[i] != -1) != reference.isReachable(0, shard.localToGlobal[i]))
+				throw std::runtime_error("sharded BFS disagrees with the sequential one");
+		}
+	});
+	check(succeeded, "sharded: every shard agrees with the sequential BFS");
+
+	bool rethrown = false;
+	try
+	{
+		runLocalShards(3, [&](ShardTransport& transport)
+		{
+			if(transport.getShardId() == 0)
+				throw std::runtime_error("shard 0 failed");
+			GraphShard<int> shard = buildShard(graph, partition, transport.getShardId());
+			shardedBFS(shard, transport, 0);
+		});
+	}
+	catch(const std::runtime_error&)
+	{
+		rethrown = true;
+	}
+	int status = 0;
+	check(rethrown, "sharded: an exception in shard 0 is rethrown");
+	check(::waitpid(-1, &status, WNOHANG) == -1 && errno == ECHILD, "sharded: every child is reaped after shard 0 throws");
+}
+
+void testDagScheduler()
+{
+	AdjacencyList<int, true, int> chain({0, 1, 2});
+	chain.addEdge(0, 1);
+	chain.addEdge(1, 2);
+
+	// idle workers must sleep while a long callback runs, not spin
+	std::clock_t cpuStart = std::clock();
+	std::vector<int> order;
+	bool acyclic = executeDag(chain, [&](const int& vertex)
+	{
+		order.push_back(vertex);
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	}, 4);
+	double cpuSeconds = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+	check(acyclic && order == std::vector<int>({0, 1, 2}), "dag: a chain runs in order");
+	check(cpuSeconds < 0.1, "dag: idle workers do not burn CPU during a 0.3s chain");
+
+	// one scheduler run twice, and again after an aborted run
+	DagScheduler<AdjacencyList<int, true, int>> scheduler(chain, 3);
+	int calls = 0;
+	std::mutex callLock;
+	auto count = [&](const int&, const int&)
+	{
+		std::lock_guard<std::mutex> guard(callLock);
+		++calls;
+	};
+	check(scheduler.execute(count) && scheduler.execute(count) && calls == 6, "dag: a scheduler can run twice");
+	bool thrown = false;
+	try
+	{
+		scheduler.execute([](const int& vertex, const int&)
+		{
+			if(vertex == 1)
+				throw std::runtime_error("vertex 1 failed");
+		});
+	}
+	catch(const std::runtime_error&)
+	{
+		thrown = true;
+	}
+	check(thrown, "dag: a callback exception is rethrown");
+	calls = 0;
+	check(scheduler.execute(count) && calls == 3, "dag: a scheduler runs cleanly after an aborted run");
+
+	chain.addEdge(2, 0);
+	TopologicalOrder<int> cyclic = topologicalSort(chain, 2);
+	check(cyclic.hasCycle && cyclic.order.empty(), "dag: a cycle is reported");
+}
+
+#ifdef GRAPH_INSTRUMENTATION
+void testInstrumentation()
+{
+	GraphInstrumentation::reset();
+	AdjacencyList<IdentityVertexMap<int>, true, int> identity(3);
+	identity.addVertex();
+	identity.addEdge(0, 1);
+	identity.addEdge(1, 2);
+	identity.isEdge(0, 2);
+	identity.BFS(0);
+	identity.eraseEdge(0, 1);
+	identity.eraseVertex(3);
+	identity.clear();
+	AdjacencyMatrix<int, true, int> matrix(std::vector<int>{0, 1});
+	matrix.printMatrix();
+	matrix.clear();
+	GraphStatsSnapshot stats = GraphInstrumentation::snapshot();
+	check(stats.get(GraphOperation::addVertex).calls == 1, "instrumentation: identity addVertex is timed");
+	check(stats.get(GraphOperation::addEdge).calls == 2, "instrumentation: identity addEdge is timed");
+	check(stats.get(GraphOperation::isEdge).calls == 1, "instrumentation: identity isEdge is timed");
+	check(stats.get(GraphOperation::BFS).calls == 1, "instrumentation: identity BFS is timed");
+	check(stats.get(GraphOperation::eraseEdge).calls == 1, "instrumentation: identity eraseEdge is timed");
+	check(stats.get(GraphOperation::eraseVertex).calls == 1, "instrumentation: identity eraseVertex is timed");
+	check(stats.get(GraphCounter::bfsVertices) == 3, "instrumentation: identity BFS counts vertices");
+	check(stats.get(GraphCounter::locateVertexCalls) == 0, "instrumentation: identity never scans for a vertex");
+	check(stats.get(GraphOperation::printMatrix).calls == 1, "instrumentation: printMatrix is timed");
+	check(stats.get(GraphOperation::clear).calls == 2, "instrumentation: clear is timed");
+
+	// internal work is not reported as user calls
+	AdjacencyList<int, true, int> list({0, 1, 2});
+	list.addEdge(0, 1);
+	list.addEdge(1, 2);
+	AdjacencyMatrix<int, true, int> weighted(std::vector<int>{0, 1, 2});
+	weighted.addEdge(0, 1);
+	weighted.addEdge(1, 2);
+	GraphInstrumentation::reset();
+	AdjacencyList<int, true, int>* inverse = list.inverseAdjacencyList();
+	delete inverse;
+	std::cout.setstate(std::ios::failbit);
+	weighted.dijkstraPath(0);
+	std::cout.clear();
+	stats = GraphInstrumentation::snapshot();
+	check(stats.get(GraphOperation::inverseAdjacencyList).calls == 1, "instrumentation: inverseAdjacencyList is timed once");
+	check(stats.get(GraphOperation::addEdge).calls == 0, "instrumentation: inverseAdjacencyList does not count addEdge calls");
+	check(stats.get(GraphOperation::dijkstraPath).calls == 1, "instrumentation: dijkstraPath is timed once");
+	check(stats.get(GraphOperation::isEdge).calls == 0, "instrumentation: dijkstraPath does not count isEdge calls");
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+	testListErase();
+	testListParallelEdges();
+	testMatrixVertices();
+	testGraphDensitySwitch();
+	testGraphParallelEdges();
+	testGraphAssignment();
+	testInverseAdjacencyList();
+	testGraphZeroWeight();
+	testMultiSourceOrdinal();
+	testMultiSourceReachability();
+	testShortestPath();
+	testMinimumSpanningForest();
+	testTriangleCounting();
+	testCompressedIdentity();
+	testCompressedWeights();
+	testShardedTraversal();
+	testDagScheduler();
+#ifdef GRAPH_INSTRUMENTATION
+	testInstrumentation();
+#endif
+	if(failures == 0)
+		std::cout << "all checks passed" << std::endl;
+	return failures;
+}
@@ -0,0 +1,455 @@
+/***********************************************************************
+** Date: 		10/19/26
+** Project :	identity_vertex_map.h
+** Programers:	Jiahao Liang
+** File:		identity_vertex_map.h
+** Purpose:		AdjacencyList specialization for dense integer vertex IDs
+** Notes:		Under IdentityVertexMap the vertex value is its own index, so
+**				there is no vertex table and no LocateVertexIndex scan. Edges
+**				live in one contiguous array per vertex instead of a linked
+**				chain, which drops the nextNode pointer from every EdgeNode.
+***********************************************************************/
+
+#pragma once
+#ifndef _IDENTITY_VERTEX_MAP_H_
+#define _IDENTITY_VERTEX_MAP_H_
+
+#include <iostream>
+#include <vector>
+#include <queue>
+#include "adjacency_list.h"
+#include "graph_instrumentation.h"
+#include "path_search.h"
+
+/*
+**	Index for the vertex/index type, e.g. int or uint32_t;
+**	vertices are always 0 .. getVertexCount()-1;
+**	usage: AdjacencyList<IdentityVertexMap<uint32_t>, true, float>;
+*/
+template<class Index=int>
+struct IdentityVertexMap
+{
+};
+
+template<class Index, bool Direction, class W>
+class AdjacencyList<IdentityVertexMap<Index>, Direction, W>
+{
+public:
+	typedef Index VertexType;
+	typedef W WeightType;
+	
+	class EdgeNode
+	{
+	public:
+		friend class AdjacencyList;
+	public:
+		EdgeNode(const Index& index = Index(), const W& weight = W())
+		:	index(index)
+		,	weight(weight)
+		{}
+	private:
+		Index index;
+		W weight;
+	};
+
+public:
+	AdjacencyList(const Index& vertexCount);
+	AdjacencyList(const AdjacencyList<IdentityVertexMap<Index>, Direction, W>& another);
+	~AdjacencyList();
+	int getVertexCount() const;
+	int getEdgeCount() const;
+	bool isDirected() const;
+	bool isEdge(const Index& srcVertex, const Index& dstVertex) const;
+	Index getVertex(const int& index) const;
+	int getVertexIndex(const Index& vertex) const;
+	template<class Visitor>
+	void forEachAdjacent(const int& srcIndex, Visitor visit) const;
+	Index addVertex();
+	void eraseVertex(const Index& vertexToDelete);
+	void addEdge(const Index& srcVertex, const Index& dstVertex, const W& weight = true);
+	void eraseEdge(const Index& srcVertex, const Index& dstVertex);
+	void clear();
+	void DFS(const Index& srcVertex) const;
+	void DFS() const;
+	void DFSInConnectedComponents() const;
+	void BFS(const Index& srcVertex) const;
+	void BFS() const;
+	void BFSInConnectedComponents() const;
+	AdjacencyList* inverseAdjacencyList();
+	std::vector<Index> shortestPath(const Index& srcVertex, const Index& dstVertex);
+	template<class Heuristic>
+	std::vector<Index> aStarPath(const Index& srcVertex, const Index& dstVertex, Heuristic heuristic);
+
+private:
+	bool isVertex(const Index& vertex) const;
+	bool eraseEdgeNode(const Index& srcIndex, const Index& dstIndex);
+	void DFS(std::vector<int>& visited, size_t srcIndex) const;
+	void BFS(std::vector<int>& visited, size_t srcIndex) const;
+
+private:
+	std::vector<std::vector<EdgeNode>>* edgeArray; // edgeArray->at(i) holds the edges leaving vertex i
+	int edgeCount;
+	PathSearchScratch<W> pathScratch; // reused by every shortestPath/aStarPath call
+};
+
+template<class Index, bool Direction, class W>
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::AdjacencyList(const Index& vertexCount)
+:	edgeArray(new std::vector<std::vector<EdgeNode>>(vertexCount))
+,	edgeCount(0)
+{}
+
+template<class Index, bool Direction, class W>
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::AdjacencyList(const AdjacencyList& another)
+:	edgeArray(new std::vector<std::vector<EdgeNode>>(*another.edgeArray))
+,	edgeCount(another.edgeCount)
+{}
+
+template<class Index, bool Direction, class W>
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::~AdjacencyList()
+{
+	clear();
+}
+
+template<class Index, bool Direction, class W>
+int
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::getVertexCount() const
+{
+	return edgeArray->size();
+}
+
+template<class Index, bool Direction, class W>
+int
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::getEdgeCount() const
+{
+	return edgeCount;
+}
+
+template<class Index, bool Direction, class W>
+bool
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::isDirected() const
+{
+	return Direction;
+}
+
+template<class Index, bool Direction, class W>
+bool
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::isVertex(const Index& vertex) const
+{
+	return vertex >= Index() && static_cast<size_t>(vertex) < edgeArray->size();
+}
+
+template<class Index, bool Direction, class W>
+bool
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::isEdge(const Index& srcVertex, const Index& dstVertex) const
+{
+	GRAPH_TIME_SCOPE(isEdge);
+	if(!isVertex(srcVertex) || !isVertex(dstVertex)) return false;
+	GRAPH_COUNT(findEdgeCalls, 1);
+	for(const auto &i : (*edgeArray)[srcVertex])
+	{
+		GRAPH_COUNT(findEdgeChain, 1);
+		if(i.index == dstVertex)
+			return true;
+	}
+	return false;
+}
+
+template<class Index, bool Direction, class W>
+Index
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::getVertex(const int& index) const
+{
+	return static_cast<Index>(index);
+}
+
+template<class Index, bool Direction, class W>
+int
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::getVertexIndex(const Index& vertex) const
+{
+	return isVertex(vertex) ? static_cast<int>(vertex) : -1;
+}
+
+template<class Index, bool Direction, class W>
+template<class Visitor>
+void
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::forEachAdjacent(const int& srcIndex, Visitor visit) const
+{
+	for(const auto &i : (*edgeArray)[srcIndex])
+	{
+		visit(static_cast<int>(i.index), i.weight);
+	}
+}
+
+template<class Index, bool Direction, class W>
+Index
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::addVertex()
+{
+	GRAPH_TIME_SCOPE(addVertex);
+	pathScratch.invalidate();
+	edgeArray->emplace_back();
+	return static_cast<Index>(edgeArray->size() - 1);
+}
+
+/*
+**	The last vertex is moved into the erased slot and takes over its index,
+**	the same swap-and-pop the generic AdjacencyList does with its vertex table.
+*/
+template<class Index, bool Direction, class W>
+void
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::eraseVertex(const Index& vertexToDelete)
+{
+	GRAPH_TIME_SCOPE(eraseVertex);
+	pathScratch.invalidate();
+	if(!isVertex(vertexToDelete)) return;
+	std::vector<EdgeNode>& outEdges = (*edgeArray)[vertexToDelete];
+	int selfLoops = 0;
+	for(const auto &i : outEdges)
+	{
+		if(i.index == vertexToDelete)
+			++selfLoops;
+	}
+	int removed = Direction ? outEdges.size() : outEdges.size() - selfLoops + selfLoops / 2;
+	outEdges.clear();
+	for(size_t i = 0; i < edgeArray->size(); ++i)
+	{
+		std::vector<EdgeNode>& edges = (*edgeArray)[i];
+		for(size_t j = 0; j < edges.size();)
+		{
+			if(edges[j].index == vertexToDelete)
+			{
+				edges[j] = edges.back();
+				edges.pop_back();
+				if(Direction)
+					++removed;
+			}
+			else
+				++j;
+		}
+	}
+	edgeCount -= removed;
+
+	Index last = static_cast<Index>(edgeArray->size() - 1);
+	if(vertexToDelete != last)
+	{
+		std::swap((*edgeArray)[vertexToDelete], (*edgeArray)[last]);
+		for(auto &i : *edgeArray)
+		{
+			for(auto &j : i)
+			{
+				if(j.index == last)
+					j.index = vertexToDelete;
+			}
+		}
+	}
+	edgeArray->pop_back();
+}
+
+template<class Index, bool Direction, class W>
+void
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::addEdge(const Index& srcVertex, const Index& dstVertex, const W& weight)
+{
+	GRAPH_TIME_SCOPE(addEdge);
+	pathScratch.invalidate();
+	if(!isVertex(srcVertex) || !isVertex(dstVertex)) return;
+	(*edgeArray)[srcVertex].emplace_back(dstVertex, weight);
+	++edgeCount;
+	if(!Direction)
+		(*edgeArray)[dstVertex].emplace_back(srcVertex, weight);
+}
+
+template<class Index, bool Direction, class W>
+void
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::eraseEdge(const Index& srcVertex, const Index& dstVertex)
+{
+	GRAPH_TIME_SCOPE(eraseEdge);
+	pathScratch.invalidate();
+	if(!isVertex(srcVertex) || !isVertex(dstVertex)) return;
+	if(!eraseEdgeNode(srcVertex, dstVertex)) return;
+	--edgeCount;
+	if(!Direction)
+		eraseEdgeNode(dstVertex, srcVertex);
+}
+
+template<class Index, bool Direction, class W>
+bool
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::eraseEdgeNode(const Index& srcIndex, const Index& dstIndex)
+{
+	std::vector<EdgeNode>& edges = (*edgeArray)[srcIndex];
+	for(size_t i = 0; i < edges.size(); ++i)
+	{
+		if(edges[i].index == dstIndex)
+		{
+			edges.erase(edges.begin() + i);
+			return true;
+		}
+	}
+	return false;
+}
+
+template<class Index, bool Direction, class W>
+void
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::DFS(const Index& srcVertex) const
+{
+	GRAPH_TIME_SCOPE(DFS);
+	if(!isVertex(srcVertex)) return;
+	std::vector<int> visited(edgeArray->size(), false);
+	std::cout << "DFS: ";
+	DFS(visited, srcVertex);
+	std::cout << "\n";
+}
+
+template<class Index, bool Direction, class W>
+void
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::DFS() const
+{
+	GRAPH_TIME_SCOPE(DFS);
+	if(edgeArray->empty()) return;
+	std::vector<int> visited(edgeArray->size(), false);
+	std::cout << "DFS: ";
+	DFS(visited, 0);
+	std::cout << "\n";
+}
+
+template<class Index, bool Direction, class W>
+void
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::DFSInConnectedComponents() const
+{
+	GRAPH_TIME_SCOPE(DFSInConnectedComponents);
+	std::vector<int> visited(edgeArray->size(), false);
+	std::cout << "DFS in Connected Components: ";
+	for(size_t i = 0; i < edgeArray->size(); ++i)
+	{
+		if(visited[i] == false)
+			DFS(visited, i);
+	}
+	std::cout << "\n";
+}
+
+template<class Index, bool Direction, class W>
+void
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::DFS(std::vector<int>& visited, size_t srcIndex) const
+{
+	GRAPH_COUNT(dfsVertices, 1);
+	std::cout << srcIndex << " ";
+	visited[srcIndex] = true;
+	for(const auto &i : (*edgeArray)[srcIndex])
+	{
+		GRAPH_COUNT(dfsEdges, 1);
+		if(visited[i.index] == false)
+			DFS(visited, i.index);
+	}
+}
+
+template<class Index, bool Direction, class W>
+void
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::BFS(const Index& srcVertex) const
+{
+	GRAPH_TIME_SCOPE(BFS);
+	if(!isVertex(srcVertex)) return;
+	std::vector<int> visited(edgeArray->size(), false);
+	std::cout << "BFS: ";
+	BFS(visited, srcVertex);
+	std::cout << "\n";
+}
+
+template<class Index, bool Direction, class W>
+void
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::BFS() const
+{
+	GRAPH_TIME_SCOPE(BFS);
+	if(edgeArray->empty()) return;
+	std::vector<int> visited(edgeArray->size(), false);
+	std::cout << "BFS: ";
+	BFS(visited, 0);
+	std::cout << "\n";
+}
+
+template<class Index, bool Direction, class W>
+void
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::BFSInConnectedComponents() const
+{
+	GRAPH_TIME_SCOPE(BFSInConnectedComponents);
+	std::vector<int> visited(edgeArray->size(), false);
+	std::cout << "BFS in Connected Components: ";
+	for(size_t i = 0; i < edgeArray->size(); ++i)
+	{
+		if(visited[i] == false)
+			BFS(visited, i);
+	}
+	std::cout << "\n";
+}
+
+template<class Index, bool Direction, class W>
+void
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::BFS(std::vector<int>& visited, size_t srcIndex) const
+{
+	std::queue<Index> q;
+	q.push(srcIndex);
+	visited[srcIndex] = true;
+	while(!q.empty())
+	{
+		Index front = q.front();
+		q.pop();
+		GRAPH_COUNT(bfsVertices, 1);
+		std::cout << front << " ";
+		for(const auto &i : (*edgeArray)[front])
+		{
+			GRAPH_COUNT(bfsEdges, 1);
+			if(visited[i.index] == false)
+			{
+				q.push(i.index);
+				visited[i.index] = true;
+			}
+		}
+	}
+}
+
+template<class Index, bool Direction, class W>
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>*
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::inverseAdjacencyList()
+{
+	GRAPH_TIME_SCOPE(inverseAdjacencyList);
+	if(Direction == false)
+		return nullptr;
+	AdjacencyList* InAL = new AdjacencyList(static_cast<Index>(edgeArray->size()));
+	for(size_t i = 0; i < edgeArray->size(); ++i)
+	{
+		for(const auto &j : (*edgeArray)[i])
+			(*InAL->edgeArray)[j.index].emplace_back(static_cast<Index>(i), j.weight);
+	}
+	InAL->edgeCount = edgeCount;
+	return InAL;
+}
+
+template<class Index, bool Direction, class W>
+std::vector<Index>
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::shortestPath(const Index& srcVertex, const Index& dstVertex)
+{
+	GRAPH_TIME_SCOPE(shortestPath);
+	return ::bidirectionalDijkstraPath(*this, pathScratch, srcVertex, dstVertex);
+}
+
+/*
+**	heuristic(vertex, dstVertex) estimates the remaining distance and must
+**	not overestimate it;
+*/
+template<class Index, bool Direction, class W>
+template<class Heuristic>
+std::vector<Index>
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::aStarPath(const Index& srcVertex, const Index& dstVertex, Heuristic heuristic)
+{
+	GRAPH_TIME_SCOPE(aStarPath);
+	return ::aStarPath(*this, pathScratch, srcVertex, dstVertex, heuristic);
+}
+
+template<class Index, bool Direction, class W>
+void
+AdjacencyList<IdentityVertexMap<Index>, Direction, W>::clear()
+{
+	GRAPH_TIME_SCOPE(clear);
+	if(edgeArray == nullptr)
+		return;
+	delete edgeArray;
+	edgeArray = nullptr;
+}
+
+#endif
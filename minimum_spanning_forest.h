@@ -0,0 +1,236 @@
+/***********************************************************************
+** Date: 		10/19/26
+** Project :	minimum_spanning_forest.h
+** Programers:	Jiahao Liang
+** File:		minimum_spanning_forest.h
+** Purpose:		Parallel Boruvka minimum spanning forest for undirected weighted graphs
+** Notes:		Every round, each component's lightest outgoing edge is found
+**				concurrently (one CAS slot per component), and the chosen edges
+**				are merged in parallel through a lock-free union-find. Ties are
+**				broken by edge id so the chosen edges can never close a cycle.
+**				Chosen edges leave the edge array at once, and the edges left
+**				inside one component are compacted away in parallel each round.
+**				Only accepts Direction=false graphs; a directed graph fails to
+**				match the overload at compile time.
+***********************************************************************/
+
+#pragma once
+#ifndef _MINIMUM_SPANNING_FOREST_H_
+#define _MINIMUM_SPANNING_FOREST_H_
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include "parallel_for.h"
+
+template<class T, class W>
+struct SpanningForestEdge
+{
+	T srcVertex;
+	T dstVertex;
+	W weight;
+};
+
+template<class T, class W>
+struct SpanningForest
+{
+	std::vector<SpanningForestEdge<T, W>> edges;
+	W totalWeight;
+};
+
+/*
+**	Union-find whose find/unite may run from many threads at once;
+**	find halves paths with a CAS that is allowed to fail, unite links
+**	one root under the other with a CAS and retries if either moved;
+*/
+class ConcurrentUnionFind
+{
+public:
+	ConcurrentUnionFind(const size_t& size)
+	:	parent(size)
+	{
+		for(size_t i = 0; i < size; ++i)
+			parent[i].store(i, std::memory_order_relaxed);
+	}
+	int find(int index)
+	{
+		for(;;)
+		{
+			int up = parent[index].load(std::memory_order_acquire);
+			if(up == index)
+				return index;
+			int grandParent = parent[up].load(std::memory_order_acquire);
+			if(up != grandParent)
+				parent[index].compare_exchange_weak(up, grandParent, std::memory_order_acq_rel);
+			index = grandParent;
+		}
+	}
+	bool unite(int first, int second)
+	{
+		for(;;)
+		{
+			first = find(first);
+			second = find(second);
+			if(first == second)
+				return false;
+			if(first < second)
+				std::swap(first, second);
+			int expected = first;
+			if(parent[first].compare_exchange_strong(expected, second, std::memory_order_acq_rel))
+				return true;
+		}
+	}
+
+private:
+	std::vector<std::atomic<int>> parent;
+};
+
+template<template<class, bool, class> class Graph, class T, class W>
+SpanningForest<typename Graph<T, false, W>::VertexType, W>
+minimumSpanningForest(const Graph<T, false, W>& graph, const unsigned& threadCount = defaultThreadCount())
+{
+	struct Edge
+	{
+		int srcIndex;
+		int dstIndex;
+		W weight;
+	};
+	const size_t grainSize = 4096;
+	const int vertexCount = graph.getVertexCount();
+
+	// every undirected edge is stored twice, keep the srcIndex < dstIndex copy;
+	// count per vertex, prefix-sum, then fill, so the edge ids do not depend on scheduling
+	std::vector<size_t> edgeOffset(vertexCount + 1, 0);
+	parallelFor(0, vertexCount, threadCount, grainSize, [&](const size_t& begin, const size_t& end, const unsigned&)
+	{
+		for(size_t i = begin; i < end; ++i)
+		{
+			size_t kept = 0;
+			graph.forEachAdjacent(i, [&](const int& j, const W&)
+			{
+				if(static_cast<int>(i) < j)
+					++kept;
+			});
+			edgeOffset[i + 1] = kept;
+		}
+	});
+	for(int i = 0; i < vertexCount; ++i)
+		edgeOffset[i + 1] += edgeOffset[i];
+	std::vector<Edge> edges(edgeOffset[vertexCount]);
+	parallelFor(0, vertexCount, threadCount, grainSize, [&](const size_t& begin, const size_t& end, const unsigned&)
+	{
+		for(size_t i = begin; i < end; ++i)
+		{
+			size_t next = edgeOffset[i];
+			graph.forEachAdjacent(i, [&](const int& j, const W& weight)
+			{
+				if(static_cast<int>(i) < j)
+					edges[next++] = Edge{static_cast<int>(i), j, weight};
+			});
+		}
+	});
+
+	auto lighter = [&](const int& first, const int& second)
+	{
+		return edges[first].weight < edges[second].weight || (edges[first].weight == edges[second].weight && first < second);
+	};
+
+	ConcurrentUnionFind components(vertexCount);
+	std::vector<int> root(vertexCount);				// each vertex's component as of the end of the last round
+	std::vector<std::atomic<int>> lightest(vertexCount);
+	std::vector<std::vector<Edge>> chosen(std::max(1u, threadCount)); // forest edges, one buffer per threadIndex
+	std::vector<char> keep;
+	std::vector<size_t> chunkOffset;
+	for(int i = 0; i < vertexCount; ++i)
+		root[i] = i;
+	while(!edges.empty())
+	{
+		parallelFor(0, vertexCount, threadCount, grainSize, [&](const size_t& begin, const size_t& end, const unsigned&)
+		{
+			for(size_t i = begin; i < end; ++i)
+				lightest[i].store(-1, std::memory_order_relaxed);
+		});
+
+		// components only change in the merge step, so root[] is exact here
+		parallelFor(0, edges.size(), threadCount, grainSize, [&](const size_t& begin, const size_t& end, const unsigned&)
+		{
+			for(size_t i = begin; i < end; ++i)
+			{
+				int roots[] = {root[edges[i].srcIndex], root[edges[i].dstIndex]};
+				if(roots[0] == roots[1]) continue;
+				for(int component : roots)
+				{
+					int current = lightest[component].load(std::memory_order_relaxed);
+					while((current == -1 || lighter(i, current))
+						&& !lightest[component].compare_exchange_weak(current, i, std::memory_order_relaxed))
+					{}
+				}
+			}
+		});
+
+		std::atomic<bool> anyMerged(false);
+		parallelFor(0, vertexCount, threadCount, grainSize, [&](const size_t& begin, const size_t& end, const unsigned& threadIndex)
+		{
+			for(size_t i = begin; i < end; ++i)
+			{
+				int edge = lightest[i].load(std::memory_order_relaxed);
+				if(edge != -1 && components.unite(edges[edge].srcIndex, edges[edge].dstIndex))
+				{
+					chosen[threadIndex].push_back(edges[edge]);
+					anyMerged.store(true, std::memory_order_relaxed);
+				}
+			}
+		});
+		if(!anyMerged.load())
+			break;
+
+		parallelFor(0, vertexCount, threadCount, grainSize, [&](const size_t& begin, const size_t& end, const unsigned&)
+		{
+			for(size_t i = begin; i < end; ++i)
+				root[i] = components.find(i);
+		});
+
+		// keep only the edges still between two components (the chosen ones are inside one now),
+		// compacted in order: count per chunk, prefix-sum, then scatter
+		size_t chunkCount = (edges.size() + grainSize - 1) / grainSize;
+		keep.resize(edges.size());
+		chunkOffset.assign(chunkCount + 1, 0);
+		parallelFor(0, edges.size(), threadCount, grainSize, [&](const size_t& begin, const size_t& end, const unsigned&)
+		{
+			size_t kept = 0;
+			for(size_t i = begin; i < end; ++i)
+			{
+				keep[i] = root[edges[i].srcIndex] != root[edges[i].dstIndex];
+				kept += keep[i];
+			}
+			chunkOffset[begin / grainSize + 1] = kept;
+		});
+		for(size_t i = 0; i < chunkCount; ++i)
+			chunkOffset[i + 1] += chunkOffset[i];
+		std::vector<Edge> remaining(chunkOffset[chunkCount]);
+		parallelFor(0, edges.size(), threadCount, grainSize, [&](const size_t& begin, const size_t& end, const unsigned&)
+		{
+			size_t next = chunkOffset[begin / grainSize];
+			for(size_t i = begin; i < end; ++i)
+			{
+				if(keep[i])
+					remaining[next++] = edges[i];
+			}
+		});
+		edges.swap(remaining);
+	}
+
+	SpanningForest<typename Graph<T, false, W>::VertexType, W> forest;
+	forest.totalWeight = W();
+	for(const auto &i : chosen)
+	{
+		for(const auto &j : i)
+		{
+			forest.edges.push_back({graph.getVertex(j.srcIndex), graph.getVertex(j.dstIndex), j.weight});
+			forest.totalWeight += j.weight;
+		}
+	}
+	return forest;
+}
+
+#endif
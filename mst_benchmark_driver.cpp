@@ -0,0 +1,66 @@
+/***********************************************************************
+** Date: 		10/19/26
+** Project :	mst_benchmark_driver.cpp
+** Programers:	Jiahao Liang
+** File:		mst_benchmark_driver.cpp
+** Purpose:		Thread scaling of minimumSpanningForest on a large random graph
+** Notes:		Build with g++ -std=c++17 -O2 -pthread mst_benchmark_driver.cpp
+**				and run as mst_benchmark_driver [vertexCount] [edgeCount]
+**				[maxThreads]. Times 1, 2, 4, ... maxThreads threads (best of
+**				a few runs each) and fails if any thread count disagrees on
+**				the forest's weight.
+***********************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include "identity_vertex_map.h"
+#include "minimum_spanning_forest.h"
+
+int main(int argc, char *argv[])
+{
+	int vertexCount = argc > 1 ? std::atoi(argv[1]) : 1000000;
+	int edgeCount = argc > 2 ? std::atoi(argv[2]) : 8 * vertexCount;
+	unsigned maxThreads = argc > 3 ? std::atoi(argv[3]) : defaultThreadCount();
+	const int repeats = 3;
+
+	std::mt19937 random(2026);
+	std::uniform_real_distribution<double> weight(0, 1);
+	AdjacencyList<IdentityVertexMap<int>, false, double> graph(vertexCount);
+	for(int i = 0; i < edgeCount; ++i)
+		graph.addEdge(random() % vertexCount, random() % vertexCount, weight(random));
+	std::cout << vertexCount << " vertices, " << graph.getEdgeCount() << " edges\n";
+
+	double baseline = 0;
+	double expectedWeight = 0;
+	for(unsigned threadCount = 1; threadCount <= maxThreads; threadCount = threadCount == maxThreads ? maxThreads + 1 : std::min(threadCount * 2, maxThreads))
+	{
+		double best = 0;
+		SpanningForest<int, double> forest;
+		for(int i = 0; i < repeats; ++i)
+		{
+			auto start = std::chrono::steady_clock::now();
+			forest = minimumSpanningForest(graph, threadCount);
+			std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+			if(i == 0 || elapsed.count() < best)
+				best = elapsed.count();
+		}
+		if(threadCount == 1)
+		{
+			baseline = best;
+			expectedWeight = forest.totalWeight;
+		}
+		else if(std::fabs(forest.totalWeight - expectedWeight) > 1e-9 * expectedWeight)
+		{
+			std::cout << "FAILED: " << threadCount << " threads found weight " << forest.totalWeight
+				<< ", 1 thread found " << expectedWeight << std::endl;
+			return 1;
+		}
+		std::cout << threadCount << " threads: " << best << " ms, speedup " << baseline / best
+			<< ", " << forest.edges.size() << " forest edges, weight " << forest.totalWeight << "\n";
+	}
+	return 0;
+}
@@ -0,0 +1,188 @@
+/***********************************************************************
+** Date: 		10/19/26
+** Project :	multi_source_bfs.h
+** Programers:	Jiahao Liang
+** File:		multi_source_bfs.h
+** Purpose:		Bit-parallel BFS from a batch of sources at once
+** Notes:		Each vertex keeps a bitmask of the sources that have reached
+**				it, so one sweep over the adjacency per level serves the whole
+**				batch (64 sources with uint64_t, N with std::bitset<N>). Works
+**				with any graph that provides getVertexCount, getVertexIndex and
+**				forEachAdjacent: AdjacencyList, AdjacencyMatrix, Graph.
+***********************************************************************/
+
+#pragma once
+#ifndef _MULTI_SOURCE_BFS_H_
+#define _MULTI_SOURCE_BFS_H_
+
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+/*
+**	How MultiSourceBFS sets and tests bits of a mask type;
+**	the primary template covers the unsigned integers;
+*/
+template<class Mask>
+struct MultiSourceMask
+{
+	static const int bits = sizeof(Mask) * 8;
+	static Mask single(const int& bit)
+	{
+		return Mask(1) << bit;
+	}
+	static bool test(const Mask& mask, const int& bit)
+	{
+		return (mask >> bit) & Mask(1);
+	}
+};
+
+template<size_t N>
+struct MultiSourceMask<std::bitset<N>>
+{
+	static const int bits = N;
+	static std::bitset<N> single(const int& bit)
+	{
+		std::bitset<N> mask;
+		mask.set(bit);
+		return mask;
+	}
+	static bool test(const std::bitset<N>& mask, const int& bit)
+	{
+		return mask.test(bit);
+	}
+};
+
+/*
+**	Graph for any graph class of this repo;
+**	Mask for the per-vertex source set, uint64_t or std::bitset<N>;
+**	the buffers are kept between run() calls, so one object can serve
+**	many batches without reallocating;
+*/
+template<class Graph, class Mask=uint64_t>
+class MultiSourceBFS
+{
+public:
+	typedef typename Graph::VertexType VertexType;
+	static const int batchSize = MultiSourceMask<Mask>::bits;
+
+public:
+	MultiSourceBFS(const Graph& graph);
+	void run(const std::vector<VertexType>& sources);
+	void run(const VertexType* sources, const int& sourceCount);
+	bool isReachable(const int& sourceOrdinal, const VertexType& vertex) const;
+	const Mask& getReached(const int& vertexIndex) const;
+	int getLevelCount() const;
+
+private:
+	const Graph& graph;
+	std::vector<Mask> seen;			// sources that reached the vertex so far
+	std::vector<Mask> visit;		// sources whose frontier holds the vertex this level
+	std::vector<Mask> visitNext;
+	int levelCount;
+};
+
+template<class Graph, class Mask>
+MultiSourceBFS<Graph, Mask>::MultiSourceBFS(const Graph& graph)
+:	graph(graph)
+,	levelCount(0)
+{}
+
+template<class Graph, class Mask>
+void
+MultiSourceBFS<Graph, Mask>::run(const std::vector<VertexType>& sources)
+{
+	run(sources.data(), sources.size());
+}
+
+/*
+**	Source i of the batch owns bit i; at most batchSize sources,
+**	sources that are not in the graph reach nothing;
+*/
+template<class Graph, class Mask>
+void
+MultiSourceBFS<Graph, Mask>::run(const VertexType* sources, const int& sourceCount)
+{
+	size_t vertexCount = graph.getVertexCount();
+	seen.assign(vertexCount, Mask());
+	visit.assign(vertexCount, Mask());
+	visitNext.assign(vertexCount, Mask());
+	levelCount = 0;
+	for(int i = 0; i < sourceCount && i < batchSize; ++i)
+	{
+		int srcIndex = graph.getVertexIndex(sources[i]);
+		if(srcIndex == -1) continue;
+		seen[srcIndex] |= MultiSourceMask<Mask>::single(i);
+		visit[srcIndex] |= MultiSourceMask<Mask>::single(i);
+	}
+
+	bool active = true;
+	while(active)
+	{
+		active = false;
+		++levelCount;
+		for(size_t i = 0; i < vertexCount; ++i)
+		{
+			if(visit[i] == Mask()) continue;
+			const Mask frontier = visit[i];
+			graph.forEachAdjacent(i, [&](const int& dstIndex, const typename Graph::WeightType&)
+			{
+				Mask discovered = frontier & ~seen[dstIndex];
+				if(discovered == Mask()) return;
+				visitNext[dstIndex] |= discovered;
+				seen[dstIndex] |= discovered;
+				active = true;
+			});
+		}
+		visit.swap(visitNext);
+		visitNext.assign(vertexCount, Mask());
+	}
+}
+
+/*
+**	false for a sourceOrdinal outside [0, batchSize), as no such bit exists;
+*/
+template<class Graph, class Mask>
+bool
+MultiSourceBFS<Graph, Mask>::isReachable(const int& sourceOrdinal, const VertexType& vertex) const
+{
+	if(sourceOrdinal < 0 || sourceOrdinal >= batchSize) return false;
+	int index = graph.getVertexIndex(vertex);
+	if(index == -1 || static_cast<size_t>(index) >= seen.size()) return false;
+	return MultiSourceMask<Mask>::test(seen[index], sourceOrdinal);
+}
+
+template<class Graph, class Mask>
+const Mask&
+MultiSourceBFS<Graph, Mask>::getReached(const int& vertexIndex) const
+{
+	return seen.at(vertexIndex);
+}
+
+template<class Graph, class Mask>
+int
+MultiSourceBFS<Graph, Mask>::getLevelCount() const
+{
+	return levelCount;
+}
+
+/*
+**	Runs BFS from every vertex in sources, batchSize at a time, and calls
+**	visitBatch(firstSourceOrdinal, bfs) after each batch; inside the callback
+**	bit i of bfs.getReached(v) stands for sources[firstSourceOrdinal + i];
+*/
+template<class Mask=uint64_t, class Graph, class Visitor>
+void
+batchedMultiSourceBFS(const Graph& graph, const std::vector<typename Graph::VertexType>& sources, Visitor visitBatch)
+{
+	MultiSourceBFS<Graph, Mask> bfs(graph);
+	const int batchSize = MultiSourceBFS<Graph, Mask>::batchSize;
+	for(size_t i = 0; i < sources.size(); i += batchSize)
+	{
+		int sourceCount = sources.size() - i < static_cast<size_t>(batchSize) ? sources.size() - i : batchSize;
+		bfs.run(sources.data() + i, sourceCount);
+		visitBatch(static_cast<int>(i), bfs);
+	}
+}
+
+#endif
@@ -0,0 +1,60 @@
+/***********************************************************************
+** Date: 		10/19/26
+** Project :	parallel_for.h
+** Programers:	Jiahao Liang
+** File:		parallel_for.h
+** Purpose:		Minimal dynamically scheduled parallel loop for the graph algorithms
+** Notes:		Threads take chunks of grainSize indices from a shared atomic
+**				cursor until the range is used up, so a few expensive indices
+**				(high degree vertices) do not leave the other threads idle.
+***********************************************************************/
+
+#pragma once
+#ifndef _PARALLEL_FOR_H_
+#define _PARALLEL_FOR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+inline unsigned
+defaultThreadCount()
+{
+	unsigned threadCount = std::thread::hardware_concurrency();
+	return threadCount == 0 ? 1 : threadCount;
+}
+
+/*
+**	Calls body(chunkBegin, chunkEnd, threadIndex) over [begin, end);
+**	threadIndex is in [0, threadCount) and lets the body keep per-thread
+**	buffers; returns once every chunk is done;
+*/
+template<class Body>
+void
+parallelFor(const size_t& begin, const size_t& end, unsigned threadCount, const size_t& grainSize, Body body)
+{
+	if(begin >= end)
+		return;
+	size_t chunkCount = (end - begin + grainSize - 1) / grainSize;
+	threadCount = std::max(1u, std::min<unsigned>(threadCount, chunkCount));
+	std::atomic<size_t> cursor(begin);
+	auto worker = [&](const unsigned& threadIndex)
+	{
+		for(;;)
+		{
+			size_t chunkBegin = cursor.fetch_add(grainSize, std::memory_order_relaxed);
+			if(chunkBegin >= end)
+				return;
+			body(chunkBegin, std::min(end, chunkBegin + grainSize), threadIndex);
+		}
+	};
+	std::vector<std::thread> threads;
+	for(unsigned i = 1; i < threadCount; ++i)
+		threads.emplace_back(worker, i);
+	worker(0);
+	for(auto &i : threads)
+		i.join();
+}
+
+#endif
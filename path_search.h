@@ -0,0 +1,286 @@
+/***********************************************************************
+** Date: 		10/19/26
+** Project :	path_search.h
+** Programers:	Jiahao Liang
+** File:		path_search.h
+** Purpose:		Point-to-point shortest paths: bidirectional Dijkstra and A*
+** Notes:		Both searches stop as soon as the target's distance is final
+**				instead of labelling every vertex like dijkstraPath. All
+**				per-query state lives in a PathSearchScratch that is reused
+**				between queries; distances are reset lazily with an epoch
+**				stamp, so a query only pays for the vertices it touches.
+**				Edge weights must be non-negative.
+***********************************************************************/
+
+#pragma once
+#ifndef _PATH_SEARCH_H_
+#define _PATH_SEARCH_H_
+
+#include <algorithm>
+#include <vector>
+
+template<class W>
+class PathSearchScratch
+{
+public:
+	template<class, class> friend struct PathSearch;
+
+	PathSearchScratch()
+	:	epoch(0)
+	,	reverseValid(false)
+	{}
+	// must be called whenever the graph the scratch is used with changes
+	void invalidate()
+	{
+		reverseValid = false;
+	}
+
+private:
+	struct HeapEntry
+	{
+		W key;
+		W distance;
+		int index;
+		bool operator>(const HeapEntry& another) const
+		{
+			return key > another.key;
+		}
+	};
+	struct Side
+	{
+		std::vector<W> distance;
+		std::vector<int> parent;
+		std::vector<unsigned> stamp;	// distance/parent are valid only where stamp == epoch
+		std::vector<HeapEntry> heap;
+	};
+
+private:
+	unsigned epoch;
+	Side forward;
+	Side backward;
+	bool reverseValid;
+	std::vector<int> reverseOffset;		// incoming edges of a directed graph, CSR layout
+	std::vector<int> reverseSource;
+	std::vector<W> reverseWeight;
+};
+
+/*
+**	The search routines; PathSearch<Graph, W> works on any graph class
+**	of this repo through getVertexCount/getVertexIndex/getVertex/forEachAdjacent;
+*/
+template<class Graph, class W>
+struct PathSearch
+{
+	typedef PathSearchScratch<W> Scratch;
+	typedef typename Scratch::HeapEntry HeapEntry;
+	typedef typename Scratch::Side Side;
+	typedef std::vector<typename Graph::VertexType> Path;
+
+	static void beginQuery(const Graph& graph, Scratch& scratch)
+	{
+		size_t vertexCount = graph.getVertexCount();
+		Side* sides[] = {&scratch.forward, &scratch.backward};
+		if(++scratch.epoch == 0 || scratch.forward.stamp.size() != vertexCount)
+		{
+			for(Side* i : sides)
+			{
+				i->stamp.assign(vertexCount, 0);
+				i->distance.resize(vertexCount);
+				i->parent.resize(vertexCount);
+			}
+			scratch.epoch = 1;
+		}
+		for(Side* i : sides)
+			i->heap.clear();
+	}
+
+	static bool isReached(const Scratch& scratch, const Side& side, const int& index)
+	{
+		return side.stamp[index] == scratch.epoch;
+	}
+
+	static void push(Scratch& scratch, Side& side, const int& index, const int& parent, const W& distance, const W& key)
+	{
+		side.stamp[index] = scratch.epoch;
+		side.distance[index] = distance;
+		side.parent[index] = parent;
+		side.heap.push_back(HeapEntry{key, distance, index});
+		std::push_heap(side.heap.begin(), side.heap.end(), std::greater<HeapEntry>());
+	}
+
+	static HeapEntry pop(Side& side)
+	{
+		std::pop_heap(side.heap.begin(), side.heap.end(), std::greater<HeapEntry>());
+		HeapEntry top = side.heap.back();
+		side.heap.pop_back();
+		return top;
+	}
+
+	static void buildReverse(const Graph& graph, Scratch& scratch)
+	{
+		size_t vertexCount = graph.getVertexCount();
+		scratch.reverseOffset.assign(vertexCount + 1, 0);
+		for(size_t i = 0; i < vertexCount; ++i)
+		{
+			graph.forEachAdjacent(i, [&](const int& dstIndex, const W&)
+			{
+				++scratch.reverseOffset[dstIndex + 1];
+			});
+		}
+		for(size_t i = 0; i < vertexCount; ++i)
+			scratch.reverseOffset[i + 1] += scratch.reverseOffset[i];
+		scratch.reverseSource.resize(scratch.reverseOffset[vertexCount]);
+		scratch.reverseWeight.resize(scratch.reverseOffset[vertexCount]);
+		std::vector<int> next(scratch.reverseOffset.begin(), scratch.reverseOffset.end() - 1);
+		for(size_t i = 0; i < vertexCount; ++i)
+		{
+			graph.forEachAdjacent(i, [&](const int& dstIndex, const W& weight)
+			{
+				scratch.reverseSource[next[dstIndex]] = i;
+				scratch.reverseWeight[next[dstIndex]] = weight;
+				++next[dstIndex];
+			});
+		}
+		scratch.reverseValid = true;
+	}
+
+	template<class Visitor>
+	static void forEachIncoming(const Graph& graph, const Scratch& scratch, const int& dstIndex, Visitor visit)
+	{
+		if(!graph.isDirected())
+		{
+			graph.forEachAdjacent(dstIndex, visit);
+			return;
+		}
+		for(int i = scratch.reverseOffset[dstIndex]; i < scratch.reverseOffset[dstIndex + 1]; ++i)
+			visit(scratch.reverseSource[i], scratch.reverseWeight[i]);
+	}
+
+	static Path bidirectionalDijkstra(const Graph& graph, Scratch& scratch, const int& srcIndex, const int& dstIndex)
+	{
+		beginQuery(graph, scratch);
+		if(graph.isDirected() && !scratch.reverseValid)
+			buildReverse(graph, scratch);
+		Side& forward = scratch.forward;
+		Side& backward = scratch.backward;
+		push(scratch, forward, srcIndex, -1, W(), W());
+		push(scratch, backward, dstIndex, -1, W(), W());
+		int meet = srcIndex == dstIndex ? srcIndex : -1;
+		W best = W();
+
+		// relaxing into a vertex the other side has reached closes a candidate path
+		auto relax = [&](Side& side, const Side& other, const int& from, const int& to, const W& distance)
+		{
+			if(isReached(scratch, side, to) && side.distance[to] <= distance)
+				return;
+			push(scratch, side, to, from, distance, distance);
+			if(isReached(scratch, other, to) && (meet == -1 || distance + other.distance[to] < best))
+			{
+				meet = to;
+				best = distance + other.distance[to];
+			}
+		};
+
+		while(!forward.heap.empty() && !backward.heap.empty())
+		{
+			if(meet != -1 && forward.heap.front().key + backward.heap.front().key >= best)
+				break;
+			if(forward.heap.front().key <= backward.heap.front().key)
+			{
+				HeapEntry top = pop(forward);
+				if(top.distance != forward.distance[top.index]) continue;
+				graph.forEachAdjacent(top.index, [&](const int& next, const W& weight)
+				{
+					relax(forward, backward, top.index, next, top.distance + weight);
+				});
+			}
+			else
+			{
+				HeapEntry top = pop(backward);
+				if(top.distance != backward.distance[top.index]) continue;
+				forEachIncoming(graph, scratch, top.index, [&](const int& previous, const W& weight)
+				{
+					relax(backward, forward, top.index, previous, top.distance + weight);
+				});
+			}
+		}
+
+		Path path;
+		if(meet == -1)
+			return path;
+		for(int i = meet; i != -1; i = forward.parent[i])
+			path.push_back(graph.getVertex(i));
+		std::reverse(path.begin(), path.end());
+		for(int i = backward.parent[meet]; i != -1; i = backward.parent[i])
+			path.push_back(graph.getVertex(i));
+		return path;
+	}
+
+	template<class Heuristic>
+	static Path aStar(const Graph& graph, Scratch& scratch, const int& srcIndex, const int& dstIndex, Heuristic& heuristic)
+	{
+		beginQuery(graph, scratch);
+		Side& forward = scratch.forward;
+		const typename Graph::VertexType target = graph.getVertex(dstIndex);
+		push(scratch, forward, srcIndex, -1, W(), heuristic(graph.getVertex(srcIndex), target));
+		bool found = false;
+		while(!forward.heap.empty())
+		{
+			HeapEntry top = pop(forward);
+			if(top.distance != forward.distance[top.index]) continue;
+			if(top.index == dstIndex)
+			{
+				found = true;
+				break;
+			}
+			graph.forEachAdjacent(top.index, [&](const int& next, const W& weight)
+			{
+				W distance = top.distance + weight;
+				if(isReached(scratch, forward, next) && forward.distance[next] <= distance)
+					return;
+				push(scratch, forward, next, top.index, distance, distance + heuristic(graph.getVertex(next), target));
+			});
+		}
+
+		Path path;
+		if(!found)
+			return path;
+		for(int i = dstIndex; i != -1; i = forward.parent[i])
+			path.push_back(graph.getVertex(i));
+		std::reverse(path.begin(), path.end());
+		return path;
+	}
+};
+
+/*
+**	Shortest path srcVertex -> dstVertex as a vertex sequence, empty when
+**	dstVertex is unreachable; pass one scratch per thread to run queries
+**	concurrently on the same graph;
+*/
+template<class Graph, class W>
+std::vector<typename Graph::VertexType>
+bidirectionalDijkstraPath(const Graph& graph, PathSearchScratch<W>& scratch, const typename Graph::VertexType& srcVertex, const typename Graph::VertexType& dstVertex)
+{
+	int srcIndex = graph.getVertexIndex(srcVertex);
+	int dstIndex = graph.getVertexIndex(dstVertex);
+	if(srcIndex == -1 || dstIndex == -1)
+		return std::vector<typename Graph::VertexType>();
+	return PathSearch<Graph, W>::bidirectionalDijkstra(graph, scratch, srcIndex, dstIndex);
+}
+
+/*
+**	heuristic(vertex, dstVertex) must never overestimate the remaining
+**	distance, otherwise the path found may not be the shortest;
+*/
+template<class Graph, class W, class Heuristic>
+std::vector<typename Graph::VertexType>
+aStarPath(const Graph& graph, PathSearchScratch<W>& scratch, const typename Graph::VertexType& srcVertex, const typename Graph::VertexType& dstVertex, Heuristic heuristic)
+{
+	int srcIndex = graph.getVertexIndex(srcVertex);
+	int dstIndex = graph.getVertexIndex(dstVertex);
+	if(srcIndex == -1 || dstIndex == -1)
+		return std::vector<typename Graph::VertexType>();
+	return PathSearch<Graph, W>::aStar(graph, scratch, srcIndex, dstIndex, heuristic);
+}
+
+#endif
@@ -0,0 +1,447 @@
+/***********************************************************************
+** Date: 		10/19/26
+** Project :	sharded_traversal.h
+** Programers:	Jiahao Liang
+** File:		sharded_traversal.h
+** Purpose:		Level-synchronous BFS and SSSP over a graph split into shard processes
+** Notes:		Every shard process holds one GraphShard (see graph_partition.h)
+**				and talks to the others through a ShardTransport. Each
+**				superstep expands the local frontier, batches the discovered
+**				ghost vertices per owning shard, and swaps one message with
+**				every peer; the first byte of each message says whether its
+**				sender still has work, which doubles as the termination vote.
+**				Messages are raw memory, so all shards must share one ABI.
+**				UnixSocketTransport connects shards forked on one machine
+**				(POSIX only); a cluster transport only needs exchange().
+***********************************************************************/
+
+#pragma once
+#ifndef _SHARDED_TRAVERSAL_H_
+#define _SHARDED_TRAVERSAL_H_
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <system_error>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "graph_partition.h"
+
+class ShardTransport
+{
+public:
+	virtual ~ShardTransport() {}
+	virtual int getShardId() const = 0;
+	virtual int getShardCount() const = 0;
+	/*
+	**	Collective: every shard calls it once per superstep. Sends outbox[peer]
+	**	to each other shard and fills inbox[peer] with what that peer sent;
+	**	the entries for this shard itself are ignored/left empty;
+	*/
+	virtual void exchange(const std::vector<std::vector<char>>& outbox, std::vector<std::vector<char>>& inbox) = 0;
+};
+
+/*
+**	Socket pairs between every two of shardCount shards; create it before
+**	forking so every process inherits the descriptors;
+*/
+class UnixSocketMesh
+{
+public:
+	friend class UnixSocketTransport;
+	UnixSocketMesh(const int& shardCount)
+	:	socket(shardCount, std::vector<int>(shardCount, -1))
+	{
+		for(int i = 0; i < shardCount; ++i)
+		{
+			for(int j = i + 1; j < shardCount; ++j)
+			{
+				int pair[2];
+				if(::socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0)
+					throw std::system_error(errno, std::generic_category(), "socketpair");
+				socket[i][j] = pair[0];
+				socket[j][i] = pair[1];
+			}
+		}
+	}
+	int getShardCount() const
+	{
+		return socket.size();
+	}
+private:
+	std::vector<std::vector<int>> socket; // socket[i][j] is shard i's end of the i-j connection
+};
+
+class UnixSocketTransport : public ShardTransport
+{
+public:
+	// keeps shardId's ends of the mesh and closes every other descriptor in this process
+	UnixSocketTransport(UnixSocketMesh& mesh, const int& shardId)
+	:	shardId(shardId)
+	,	peer(mesh.getShardCount(), -1)
+	{
+		for(int i = 0; i < mesh.getShardCount(); ++i)
+		{
+			for(int j = 0; j < mesh.getShardCount(); ++j)
+			{
+				int& fd = mesh.socket[i][j];
+				if(fd == -1) continue;
+				if(i == shardId)
+					peer[j] = fd;
+				else
+					::close(fd);
+				fd = -1;
+			}
+		}
+	}
+	~UnixSocketTransport()
+	{
+		for(int fd : peer)
+		{
+			if(fd != -1)
+				::close(fd);
+		}
+	}
+	int getShardId() const
+	{
+		return shardId;
+	}
+	int getShardCount() const
+	{
+		return peer.size();
+	}
+	/*
+	**	Peers are served in increasing order, the lower id of each pair
+	**	sending first; every process then walks the pairs in the same global
+	**	order, so blocking sends cannot deadlock whatever the message sizes;
+	*/
+	void exchange(const std::vector<std::vector<char>>& outbox, std::vector<std::vector<char>>& inbox)
+	{
+		inbox.assign(peer.size(), std::vector<char>());
+		for(size_t i = 0; i < peer.size(); ++i)
+		{
+			if(static_cast<int>(i) == shardId) continue;
+			if(shardId < static_cast<int>(i))
+			{
+				sendMessage(peer[i], outbox[i]);
+				receiveMessage(peer[i], inbox[i]);
+			}
+			else
+			{
+				receiveMessage(peer[i], inbox[i]);
+				sendMessage(peer[i], outbox[i]);
+			}
+		}
+	}
+
+private:
+	static void writeAll(const int& fd, const char* data, size_t size)
+	{
+		while(size > 0)
+		{
+#ifdef MSG_NOSIGNAL
+			ssize_t written = ::send(fd, data, size, MSG_NOSIGNAL);
+#else
+			ssize_t written = ::send(fd, data, size, 0);
+#endif
+			if(written < 0 && errno == EINTR) continue;
+			if(written <= 0)
+				throw std::system_error(errno, std::generic_category(), "shard send");
+			data += written;
+			size -= written;
+		}
+	}
+	static void readAll(const int& fd, char* data, size_t size)
+	{
+		while(size > 0)
+		{
+			ssize_t received = ::recv(fd, data, size, 0);
+			if(received < 0 && errno == EINTR) continue;
+			if(received == 0)
+				throw std::system_error(ECONNRESET, std::generic_category(), "shard peer closed");
+			if(received < 0)
+				throw std::system_error(errno, std::generic_category(), "shard recv");
+			data += received;
+			size -= received;
+		}
+	}
+	static void sendMessage(const int& fd, const std::vector<char>& message)
+	{
+		uint64_t size = message.size();
+		writeAll(fd, reinterpret_cast<const char*>(&size), sizeof(size));
+		writeAll(fd, message.data(), message.size());
+	}
+	static void receiveMessage(const int& fd, std::vector<char>& message)
+	{
+		uint64_t size = 0;
+		readAll(fd, reinterpret_cast<char*>(&size), sizeof(size));
+		message.resize(size);
+		readAll(fd, message.data(), size);
+	}
+
+private:
+	int shardId;
+	std::vector<int> peer;
+};
+
+/*
+**	Forks shardCount - 1 children and runs body(transport) as every shard,
+**	the calling process being shard 0; a child exits with 1 if body throws;
+**	returns true when every child exited with 0; if shard 0's body throws
+**	(or a fork fails), its sockets are closed so blocked children fail
+**	too, every child is reaped, and then the exception is rethrown;
+*/
+template<class Body>
+bool
+runLocalShards(const int& shardCount, Body body)
+{
+	UnixSocketMesh mesh(shardCount);
+	std::vector<pid_t> children;
+	std::exception_ptr failure;
+	for(int i = 1; i < shardCount && !failure; ++i)
+	{
+		pid_t pid = ::fork();
+		if(pid < 0)
+		{
+			failure = std::make_exception_ptr(std::system_error(errno, std::generic_category(), "fork"));
+			break;
+		}
+		if(pid == 0)
+		{
+			int status = 0;
+			try
+			{
+				UnixSocketTransport transport(mesh, i);
+				body(static_cast<ShardTransport&>(transport));
+			}
+			catch(...)
+			{
+				status = 1;
+			}
+			::_exit(status);
+		}
+		children.push_back(pid);
+	}
+	try
+	{
+		// also closes every descriptor of shards that were never forked
+		UnixSocketTransport transport(mesh, 0);
+		if(!failure)
+			body(static_cast<ShardTransport&>(transport));
+	}
+	catch(...)
+	{
+		failure = std::current_exception();
+	}
+	bool succeeded = true;
+	for(pid_t child : children)
+	{
+		int status = 0;
+		while(::waitpid(child, &status, 0) < 0 && errno == EINTR)
+		{}
+		succeeded = succeeded && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+	}
+	if(failure)
+		std::rethrow_exception(failure);
+	return succeeded;
+}
+
+template<class W>
+struct ShardedTraversal
+{
+	typedef std::vector<std::vector<char>> Mailbox;
+
+	template<class Record>
+	static void append(std::vector<char>& message, const Record& record)
+	{
+		const char* raw = reinterpret_cast<const char*>(&record);
+		message.insert(message.end(), raw, raw + sizeof(Record));
+	}
+
+	template<class Record, class Visitor>
+	static void forEachRecord(const std::vector<char>& message, Visitor visit)
+	{
+		for(size_t i = 1; i + sizeof(Record) <= message.size(); i += sizeof(Record))
+		{
+			Record record;
+			std::memcpy(&record, message.data() + i, sizeof(Record));
+			visit(record);
+		}
+	}
+
+	// swaps the outboxes and returns whether any shard, this one included, is still active
+	static bool exchange(ShardTransport& transport, Mailbox& outbox, Mailbox& inbox, const bool& localActive)
+	{
+		bool active = localActive;
+		for(const auto &i : outbox)
+			active = active || i.size() > 1;
+		for(auto &i : outbox)
+			i[0] = active;
+		transport.exchange(outbox, inbox);
+		bool anyActive = active;
+		for(size_t i = 0; i < inbox.size(); ++i)
+		{
+			if(static_cast<int>(i) != transport.getShardId() && !inbox[i].empty() && inbox[i][0])
+				anyActive = true;
+		}
+		for(auto &i : outbox)
+			i.assign(1, 0);
+		return anyActive;
+	}
+};
+
+/*
+**	BFS levels of this shard's vertices (indexed like shard.localToGlobal)
+**	from the global vertex index srcIndex, -1 where unreachable; every
+**	shard must call it with the same srcIndex;
+*/
+template<class W>
+std::vector<int>
+shardedBFS(const GraphShard<W>& shard, ShardTransport& transport, const int& srcIndex)
+{
+	typedef ShardedTraversal<W> Traversal;
+	std::vector<int> level(shard.localToGlobal.size(), -1);
+	std::vector<char> ghostSent(shard.ghostGlobal.size(), false); // a ghost's first discovery is already its shortest
+	std::vector<int> frontier, next;
+	typename Traversal::Mailbox outbox(shard.shardCount, std::vector<char>(1, 0)), inbox;
+
+	auto found = shard.globalToLocal.find(srcIndex);
+	if(found != shard.globalToLocal.end())
+	{
+		level[found->second] = 0;
+		frontier.push_back(found->second);
+	}
+	for(int depth = 0; ; ++depth)
+	{
+		next.clear();
+		for(int vertex : frontier)
+		{
+			for(size_t i = shard.offset[vertex]; i < shard.offset[vertex + 1]; ++i)
+			{
+				int target = shard.target[i];
+				if(target >= 0)
+				{
+					if(level[target] != -1) continue;
+					level[target] = depth + 1;
+					next.push_back(target);
+				}
+				else
+				{
+					int ghost = -target - 1;
+					if(ghostSent[ghost]) continue;
+					ghostSent[ghost] = true;
+					Traversal::append(outbox[shard.ghostOwner[ghost]], static_cast<int32_t>(shard.ghostGlobal[ghost]));
+				}
+			}
+		}
+		if(!Traversal::exchange(transport, outbox, inbox, !next.empty()))
+			break;
+		for(size_t i = 0; i < inbox.size(); ++i)
+		{
+			Traversal::template forEachRecord<int32_t>(inbox[i], [&](const int32_t& global)
+			{
+				int local = shard.globalToLocal.at(global);
+				if(level[local] != -1) return;
+				level[local] = depth + 1;
+				next.push_back(local);
+			});
+		}
+		frontier.swap(next);
+	}
+	return level;
+}
+
+/*
+**	Shortest distances of this shard's vertices from the global vertex
+**	index srcIndex, std::numeric_limits<W>::max() where unreachable; a
+**	frontier-based Bellman-Ford, so weights must be non-negative for it to
+**	settle quickly, but any order of arrival is correct;
+*/
+template<class W>
+std::vector<W>
+shardedSSSP(const GraphShard<W>& shard, ShardTransport& transport, const int& srcIndex)
+{
+	typedef ShardedTraversal<W> Traversal;
+	struct Relaxation
+	{
+		int32_t global;
+		W distance;
+	};
+	const W unreachable = std::numeric_limits<W>::max();
+	std::vector<W> distance(shard.localToGlobal.size(), unreachable);
+	std::vector<W> ghostBest(shard.ghostGlobal.size(), unreachable); // best distance already sent per ghost
+	std::vector<int> ghostRound(shard.ghostGlobal.size(), -1);		// last superstep the ghost was queued in
+	std::vector<char> inNext(shard.localToGlobal.size(), false);
+	std::vector<int> frontier, next, pendingGhosts;
+	typename Traversal::Mailbox outbox(shard.shardCount, std::vector<char>(1, 0)), inbox;
+
+	auto improve = [&](const int& local, const W& candidate)
+	{
+		if(candidate >= distance[local]) return;
+		distance[local] = candidate;
+		if(!inNext[local])
+		{
+			inNext[local] = true;
+			next.push_back(local);
+		}
+	};
+
+	auto found = shard.globalToLocal.find(srcIndex);
+	if(found != shard.globalToLocal.end())
+	{
+		distance[found->second] = W();
+		frontier.push_back(found->second);
+	}
+	for(int round = 0; ; ++round)
+	{
+		next.clear();
+		pendingGhosts.clear();
+		for(int vertex : frontier)
+			inNext[vertex] = false;
+		for(int vertex : frontier)
+		{
+			for(size_t i = shard.offset[vertex]; i < shard.offset[vertex + 1]; ++i)
+			{
+				W candidate = distance[vertex] + shard.weight[i];
+				int target = shard.target[i];
+				if(target >= 0)
+					improve(target, candidate);
+				else
+				{
+					int ghost = -target - 1;
+					if(candidate >= ghostBest[ghost]) continue;
+					ghostBest[ghost] = candidate;
+					if(ghostRound[ghost] != round)
+					{
+						ghostRound[ghost] = round;
+						pendingGhosts.push_back(ghost);
+					}
+				}
+			}
+		}
+		// one record per ghost per superstep, carrying its best candidate
+		for(int ghost : pendingGhosts)
+		{
+			Relaxation relaxation = {static_cast<int32_t>(shard.ghostGlobal[ghost]), ghostBest[ghost]};
+			Traversal::append(outbox[shard.ghostOwner[ghost]], relaxation);
+		}
+		if(!Traversal::exchange(transport, outbox, inbox, !next.empty()))
+			break;
+		for(size_t i = 0; i < inbox.size(); ++i)
+		{
+			Traversal::template forEachRecord<Relaxation>(inbox[i], [&](const Relaxation& relaxation)
+			{
+				improve(shard.globalToLocal.at(relaxation.global), relaxation.distance);
+			});
+		}
+		frontier.swap(next);
+	}
+	return distance;
+}
+
+#endif
@@ -0,0 +1,274 @@
+/***********************************************************************
+** Date: 		10/19/26
+** Project :	topological_sort.h
+** Programers:	Jiahao Liang
+** File:		topological_sort.h
+** Purpose:		Parallel topological sort and DAG task execution for directed AdjacencyLists
+** Notes:		Kahn's algorithm run by a pool of workers: every vertex has
+**				an atomic in-degree counter, and whoever finishes a vertex's
+**				last predecessor pushes it onto its own ready deque. Idle
+**				workers steal from the other end of another worker's deque,
+**				and sleep on a condition variable while every deque is empty.
+**				Vertices left with predecessors when the pool drains lie on
+**				or behind a cycle. Only Direction=true graphs are accepted.
+***********************************************************************/
+
+#pragma once
+#ifndef _TOPOLOGICAL_SORT_H_
+#define _TOPOLOGICAL_SORT_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "adjacency_list.h"
+#include "parallel_for.h"
+
+/*
+**	order lists the vertices so every edge points forward in it;
+**	levels[k] holds the vertices whose longest path from a source has k
+**	edges, so each level only depends on earlier ones;
+**	when hasCycle is set, the vertices on or behind a cycle are missing;
+*/
+template<class T>
+struct TopologicalOrder
+{
+	std::vector<T> order;
+	std::vector<std::vector<T>> levels;
+	bool hasCycle;
+};
+
+template<class Graph>
+class DagScheduler
+{
+public:
+	DagScheduler(const Graph& graph, const unsigned& threadCount)
+	:	graph(graph)
+	,	threadCount(threadCount == 0 ? 1 : threadCount)
+	,	inDegree(graph.getVertexCount())
+	,	level(graph.getVertexCount())
+	,	ready(this->threadCount)
+	,	queued(0)
+	,	pending(0)
+	,	completed(0)
+	,	aborted(false)
+	{}
+
+	/*
+	**	Calls run(vertexIndex, level) for every vertex once all its
+	**	predecessors' calls have returned; returns false on a cycle;
+	**	may be called again, each call starts from a clean state;
+	*/
+	template<class Run>
+	bool execute(Run run)
+	{
+		typedef typename Graph::WeightType W;
+		const size_t vertexCount = graph.getVertexCount();
+		for(auto &i : ready)
+			i.vertexs.clear(); // an aborted run may leave vertices behind
+		queued.store(0);
+		pending.store(0);
+		completed.store(0);
+		aborted.store(false);
+		failure = nullptr;
+		for(size_t i = 0; i < vertexCount; ++i)
+		{
+			inDegree[i].store(0, std::memory_order_relaxed);
+			level[i].store(0, std::memory_order_relaxed);
+		}
+		parallelFor(0, vertexCount, threadCount, 1024, [&](const size_t& begin, const size_t& end, const unsigned&)
+		{
+			for(size_t i = begin; i < end; ++i)
+			{
+				graph.forEachAdjacent(i, [&](const int& j, const W&)
+				{
+					inDegree[j].fetch_add(1, std::memory_order_relaxed);
+				});
+			}
+		});
+		unsigned nextQueue = 0;
+		for(size_t i = 0; i < vertexCount; ++i)
+		{
+			if(inDegree[i].load(std::memory_order_relaxed) != 0) continue;
+			ready[nextQueue].vertexs.push_back(i);
+			nextQueue = (nextQueue + 1) % threadCount;
+			++queued;
+			++pending;
+		}
+
+		std::vector<std::thread> workers;
+		for(unsigned i = 1; i < threadCount; ++i)
+			workers.emplace_back([&, i]() { work(i, run); });
+		work(0, run);
+		for(auto &i : workers)
+			i.join();
+		if(failure)
+			std::rethrow_exception(failure);
+		return completed.load() == vertexCount;
+	}
+
+private:
+	struct ReadyQueue
+	{
+		std::mutex lock;
+		std::deque<int> vertexs; // the owner works at the back, thieves take from the front
+	};
+
+	bool take(const unsigned& self, int& vertex)
+	{
+		for(unsigned i = 0; i < threadCount; ++i)
+		{
+			ReadyQueue& queue = ready[(self + i) % threadCount];
+			std::lock_guard<std::mutex> guard(queue.lock);
+			if(queue.vertexs.empty()) continue;
+			if(i == 0)
+			{
+				vertex = queue.vertexs.back();
+				queue.vertexs.pop_back();
+			}
+			else
+			{
+				vertex = queue.vertexs.front();
+				queue.vertexs.pop_front();
+			}
+			--queued;
+			return true;
+		}
+		return false;
+	}
+
+	// taking idleLock orders the state change before a waiter's predicate check
+	void wake(const bool& everyone)
+	{
+		{
+			std::lock_guard<std::mutex> guard(idleLock);
+		}
+		if(everyone)
+			idle.notify_all();
+		else
+			idle.notify_one();
+	}
+
+	template<class Run>
+	void work(const unsigned& self, Run& run)
+	{
+		typedef typename Graph::WeightType W;
+		int vertex;
+		while(!aborted.load(std::memory_order_relaxed))
+		{
+			if(!take(self, vertex))
+			{
+				std::unique_lock<std::mutex> guard(idleLock);
+				idle.wait(guard, [&]()
+				{
+					return queued.load() != 0 || pending.load() == 0 || aborted.load();
+				});
+				if(pending.load() == 0)
+					return;
+				continue;
+			}
+			int vertexLevel = level[vertex].load(std::memory_order_relaxed);
+			try
+			{
+				run(vertex, vertexLevel);
+			}
+			catch(...)
+			{
+				std::lock_guard<std::mutex> guard(failureLock);
+				if(!failure)
+					failure = std::current_exception();
+				aborted.store(true);
+				wake(true);
+				return;
+			}
+			graph.forEachAdjacent(vertex, [&](const int& next, const W&)
+			{
+				int nextLevel = level[next].load(std::memory_order_relaxed);
+				while(nextLevel < vertexLevel + 1
+					&& !level[next].compare_exchange_weak(nextLevel, vertexLevel + 1, std::memory_order_relaxed))
+				{}
+				if(inDegree[next].fetch_sub(1, std::memory_order_acq_rel) == 1)
+				{
+					++pending;
+					{
+						ReadyQueue& queue = ready[self];
+						std::lock_guard<std::mutex> guard(queue.lock);
+						queue.vertexs.push_back(next);
+						++queued;
+					}
+					wake(false);
+				}
+			});
+			++completed;
+			if(--pending == 0)
+				wake(true);
+		}
+	}
+
+private:
+	const Graph& graph;
+	unsigned threadCount;
+	std::vector<std::atomic<int>> inDegree;
+	std::vector<std::atomic<int>> level;	// longest path length from a source, final once the vertex is ready
+	std::vector<ReadyQueue> ready;
+	std::mutex idleLock;
+	std::condition_variable idle;			// signalled when a vertex is queued, pending reaches 0 or the run aborts
+	std::atomic<size_t> queued;				// vertices sitting in a ready deque
+	std::atomic<size_t> pending;			// vertices queued or running
+	std::atomic<size_t> completed;
+	std::atomic<bool> aborted;
+	std::mutex failureLock;
+	std::exception_ptr failure;
+};
+
+/*
+**	Runs callback(vertex) for every vertex of the DAG on threadCount
+**	threads, each as soon as all of its predecessors' callbacks returned;
+**	returns false, after running everything it could, if the graph has a
+**	cycle; an exception from a callback stops the run and is rethrown;
+*/
+template<class T, class W, class Callback>
+bool
+executeDag(const AdjacencyList<T, true, W>& graph, Callback callback, const unsigned& threadCount = defaultThreadCount())
+{
+	DagScheduler<AdjacencyList<T, true, W>> scheduler(graph, threadCount);
+	return scheduler.execute([&](const int& vertex, const int&)
+	{
+		callback(graph.getVertex(vertex));
+	});
+}
+
+template<class T, class W>
+TopologicalOrder<typename AdjacencyList<T, true, W>::VertexType>
+topologicalSort(const AdjacencyList<T, true, W>& graph, const unsigned& threadCount = defaultThreadCount())
+{
+	typedef typename AdjacencyList<T, true, W>::VertexType VertexType;
+	std::vector<int> order(graph.getVertexCount());
+	std::vector<int> level(graph.getVertexCount(), -1);
+	std::atomic<size_t> position(0);
+	DagScheduler<AdjacencyList<T, true, W>> scheduler(graph, threadCount);
+	bool acyclic = scheduler.execute([&](const int& vertex, const int& vertexLevel)
+	{
+		// a vertex takes its slot before releasing its successors, so edges point forward
+		order[position.fetch_add(1)] = vertex;
+		level[vertex] = vertexLevel;
+	});
+
+	TopologicalOrder<VertexType> result;
+	result.hasCycle = !acyclic;
+	result.order.reserve(position.load());
+	for(size_t i = 0; i < position.load(); ++i)
+	{
+		int vertex = order[i];
+		result.order.push_back(graph.getVertex(vertex));
+		if(static_cast<size_t>(level[vertex]) >= result.levels.size())
+			result.levels.resize(level[vertex] + 1);
+		result.levels[level[vertex]].push_back(graph.getVertex(vertex));
+	}
+	return result;
+}
+
+#endif
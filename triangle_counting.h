@@ -0,0 +1,223 @@
+/***********************************************************************
+** Date: 		10/19/26
+** Project :	triangle_counting.h
+** Programers:	Jiahao Liang
+** File:		triangle_counting.h
+** Purpose:		Per-vertex triangle counts and local clustering coefficients
+** Notes:		The graph is first flattened into sorted, deduplicated neighbour
+**				arrays (direction and self-loops ignored) and every edge is
+**				oriented from the lower to the higher (degree, index) end, so
+**				each triangle is found exactly once and high degree vertices
+**				keep short out-lists. Triangles through an edge u->v are the
+**				intersection of out(u) and out(v): an SSE2 block merge when the
+**				lists are of similar length, galloping search when one is much
+**				shorter. Vertices are spread over threads with parallelFor.
+***********************************************************************/
+
+#pragma once
+#ifndef _TRIANGLE_COUNTING_H_
+#define _TRIANGLE_COUNTING_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "parallel_for.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+**	All vectors are indexed by vertex index (see getVertexIndex);
+*/
+struct TriangleCounts
+{
+	uint64_t totalTriangles;
+	std::vector<uint64_t> triangles;		// triangles through each vertex
+	std::vector<int> degree;				// distinct neighbours, ignoring direction
+	std::vector<double> clustering;			// triangles / (degree choose 2)
+};
+
+/*
+**	Calls found(x) for every x in both sorted, duplicate-free ranges;
+*/
+template<class Found>
+void
+intersectSortedGalloping(const int* small, const int* smallEnd, const int* large, const int* largeEnd, Found& found)
+{
+	for(; small != smallEnd && large != largeEnd; ++small)
+	{
+		size_t step = 1;
+		while(large + step < largeEnd && large[step] < *small)
+			step <<= 1;
+		large = std::lower_bound(large + (step >> 1), std::min(large + step + 1, largeEnd), *small);
+		if(large != largeEnd && *large == *small)
+			found(*small);
+	}
+}
+
+template<class Found>
+void
+intersectSortedMerge(const int* first, const int* firstEnd, const int* second, const int* secondEnd, Found& found)
+{
+#if defined(__SSE2__)
+	// compare 4 values of first against all 4 rotations of 4 values of second
+	while(firstEnd - first >= 4 && secondEnd - second >= 4)
+	{
+		__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+		__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second));
+		__m128i equal = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi32(a, b), _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b, _MM_SHUFFLE(0, 3, 2, 1)))),
+			_mm_or_si128(_mm_cmpeq_epi32(a, _mm_shuffle_epi32(b, _MM_SHUFFLE(1, 0, 3, 2))), _mm_cmpeq_epi32(a, _mm_shuffle_epi32(b, _MM_SHUFFLE(2, 1, 0, 3)))));
+		int mask = _mm_movemask_ps(_mm_castsi128_ps(equal));
+		for(int i = 0; mask != 0; ++i, mask >>= 1)
+		{
+			if(mask & 1)
+				found(first[i]);
+		}
+		int firstLast = first[3];
+		int secondLast = second[3];
+		if(firstLast <= secondLast)
+			first += 4;
+		if(secondLast <= firstLast)
+			second += 4;
+	}
+#endif
+	while(first != firstEnd && second != secondEnd)
+	{
+		if(*first < *second)
+			++first;
+		else if(*second < *first)
+			++second;
+		else
+		{
+			found(*first);
+			++first;
+			++second;
+		}
+	}
+}
+
+template<class Found>
+void
+intersectSorted(const int* first, const int* firstEnd, const int* second, const int* secondEnd, Found found)
+{
+	const size_t gallopRatio = 32;
+	size_t firstSize = firstEnd - first;
+	size_t secondSize = secondEnd - second;
+	if(firstSize * gallopRatio < secondSize)
+		intersectSortedGalloping(first, firstEnd, second, secondEnd, found);
+	else if(secondSize * gallopRatio < firstSize)
+		intersectSortedGalloping(second, secondEnd, first, firstEnd, found);
+	else
+		intersectSortedMerge(first, firstEnd, second, secondEnd, found);
+}
+
+template<class Graph>
+TriangleCounts
+countTriangles(const Graph& graph, const unsigned& threadCount = defaultThreadCount())
+{
+	typedef typename Graph::WeightType W;
+	const size_t vertexCount = graph.getVertexCount();
+	const size_t grainSize = 64;
+
+	// undirected neighbour arrays in CSR form, both directions of every edge
+	std::vector<size_t> offset(vertexCount + 1, 0);
+	for(size_t i = 0; i < vertexCount; ++i)
+	{
+		graph.forEachAdjacent(i, [&](const int& j, const W&)
+		{
+			if(static_cast<size_t>(j) == i) return;
+			++offset[i + 1];
+			++offset[j + 1];
+		});
+	}
+	for(size_t i = 0; i < vertexCount; ++i)
+		offset[i + 1] += offset[i];
+	std::vector<int> neighbour(offset[vertexCount]);
+	std::vector<size_t> next(offset.begin(), offset.end() - 1);
+	for(size_t i = 0; i < vertexCount; ++i)
+	{
+		graph.forEachAdjacent(i, [&](const int& j, const W&)
+		{
+			if(static_cast<size_t>(j) == i) return;
+			neighbour[next[i]++] = j;
+			neighbour[next[j]++] = i;
+		});
+	}
+
+	TriangleCounts counts;
+	counts.degree.assign(vertexCount, 0);
+	parallelFor(0, vertexCount, threadCount, grainSize, [&](const size_t& begin, const size_t& end, const unsigned&)
+	{
+		for(size_t i = begin; i < end; ++i)
+		{
+			std::sort(neighbour.begin() + offset[i], neighbour.begin() + offset[i + 1]);
+			counts.degree[i] = std::unique(neighbour.begin() + offset[i], neighbour.begin() + offset[i + 1]) - neighbour.begin() - offset[i];
+		}
+	});
+
+	// keep only the neighbours ranked above each vertex, still sorted by index
+	auto precedes = [&](const int& u, const int& v)
+	{
+		return counts.degree[u] < counts.degree[v] || (counts.degree[u] == counts.degree[v] && u < v);
+	};
+	std::vector<int> outDegree(vertexCount);
+	parallelFor(0, vertexCount, threadCount, grainSize, [&](const size_t& begin, const size_t& end, const unsigned&)
+	{
+		for(size_t i = begin; i < end; ++i)
+		{
+			int* write = &neighbour[0] + offset[i];
+			for(int j = 0; j < counts.degree[i]; ++j)
+			{
+				int v = neighbour[offset[i] + j];
+				if(precedes(i, v))
+					*write++ = v;
+			}
+			outDegree[i] = write - &neighbour[0] - offset[i];
+		}
+	});
+
+	std::vector<std::atomic<uint64_t>> triangles(vertexCount);
+	for(auto &i : triangles)
+		i.store(0, std::memory_order_relaxed);
+	parallelFor(0, vertexCount, threadCount, grainSize, [&](const size_t& begin, const size_t& end, const unsigned&)
+	{
+		for(size_t u = begin; u < end; ++u)
+		{
+			const int* outU = &neighbour[0] + offset[u];
+			uint64_t atU = 0;
+			for(int j = 0; j < outDegree[u]; ++j)
+			{
+				int v = outU[j];
+				const int* outV = &neighbour[0] + offset[v];
+				uint64_t atV = 0;
+				intersectSorted(outU, outU + outDegree[u], outV, outV + outDegree[v], [&](const int& w)
+				{
+					++atV;
+					triangles[w].fetch_add(1, std::memory_order_relaxed);
+				});
+				atU += atV;
+				if(atV != 0)
+					triangles[v].fetch_add(atV, std::memory_order_relaxed);
+			}
+			if(atU != 0)
+				triangles[u].fetch_add(atU, std::memory_order_relaxed);
+		}
+	});
+
+	counts.totalTriangles = 0;
+	counts.triangles.resize(vertexCount);
+	counts.clustering.resize(vertexCount);
+	for(size_t i = 0; i < vertexCount; ++i)
+	{
+		counts.triangles[i] = triangles[i].load(std::memory_order_relaxed);
+		counts.totalTriangles += counts.triangles[i];
+		double degree = counts.degree[i];
+		counts.clustering[i] = degree < 2 ? 0 : 2 * counts.triangles[i] / (degree * (degree - 1));
+	}
+	counts.totalTriangles /= 3;
+	return counts;
+}
+
+#endif